@@ -0,0 +1,237 @@
+/*!
+ *  \file    adpcm.c
+ *  \brief   IMA/DVI ADPCM decoder (WAV format tag 0x11)
+ *
+ *  \details Layout of a block with c channels:
+ *           - per channel 4 header bytes: first sample (16-bit little
+ *             endian), step index, reserved;
+ *           - mono: every byte holds two samples, low nibble first;
+ *           - stereo: groups of 4 bytes left (8 samples) and 4 bytes right.
+ *           .
+ *           The decoder works per byte (mono) or per group of 8 bytes
+ *           (stereo). A group that does not fit in the output is decoded
+ *           into pend[] and handed out by the next calls.
+ */
+#include "adpcm.h"
+
+#include <avr/pgmspace.h>
+
+static const uint16_t step_table[89] PROGMEM = {
+      7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+     19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+     50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+    130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+    337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+    876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+   2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+   5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+  15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+static const int8_t index_table[8] PROGMEM = {
+  -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+static cycles_t ad_load;                //!< cycles in adpcm_decode()
+static uint32_t ad_samples;             //!< samples decoded
+
+/*! \brief  Decode one nibble of a channel
+ *
+ *  \param  ad       decoder
+ *  \param  ch       channel
+ *  \param  nib      4-bit code
+ *
+ *  \return the new sample as offset binary (0x8000 is silence)
+ */
+static inline uint16_t expand(adpcm_t *ad, uint8_t ch, uint8_t nib)
+{
+  uint16_t step = pgm_read_word(&step_table[ad->index[ch]]);
+  uint16_t diff = step >> 3;
+  int32_t  s;
+  int8_t   idx;
+
+  if (nib & 4) diff += step;
+  if (nib & 2) diff += step >> 1;
+  if (nib & 1) diff += step >> 2;
+
+  s = ad->pred[ch];
+  if (nib & 8) s -= diff;
+  else         s += diff;
+  if (s >  32767) s =  32767;
+  if (s < -32768) s = -32768;
+  ad->pred[ch] = s;
+
+  idx = ad->index[ch] + (int8_t) pgm_read_byte(&index_table[nib & 7]);
+  if (idx < 0)  idx = 0;
+  if (idx > 88) idx = 88;
+  ad->index[ch] = idx;
+
+  return (uint16_t) s ^ 0x8000;
+}
+
+/*! \brief  Read the block header and return the first frame
+ *
+ *  \param  ad       decoder
+ *
+ *  \return 12-bit DAC code of the first frame of the block
+ */
+static uint16_t header(adpcm_t *ad)
+{
+  const uint8_t *p = ad->blk;
+  uint16_t       code = 0;
+  uint8_t        ch;
+
+  for (ch = 0; ch < ad->channels; ch++, p += 4) {
+    ad->pred[ch]  = (int16_t) (p[0] | (p[1] << 8));
+    ad->index[ch] = p[2] > 88 ? 88 : p[2];
+    code += ((uint16_t) ad->pred[ch] ^ 0x8000) >> (ad->channels - 1);
+  }
+  ad->pos = 4 * ad->channels;
+
+  return code >> 4;
+}
+
+/*! \brief  Decode one byte of a mono block into two frames */
+static void group_mono(adpcm_t *ad, uint16_t *out)
+{
+  uint8_t b = ad->blk[ad->pos++];
+
+  out[0] = expand(ad, 0, b & 0x0F) >> 4;
+  out[1] = expand(ad, 0, b >> 4)   >> 4;
+}
+
+/*! \brief  Decode a group of 8 bytes of a stereo block into 8 frames */
+static void group_stereo(adpcm_t *ad, uint16_t *out)
+{
+  const uint8_t *p = ad->blk + ad->pos;
+  uint8_t        i;
+
+  for (i = 0; i < 4; i++) {
+    out[2 * i]     = expand(ad, 0, p[i] & 0x0F) >> 1;
+    out[2 * i + 1] = expand(ad, 0, p[i] >> 4)   >> 1;
+  }
+  for (i = 0; i < 4; i++) {
+    out[2 * i]     = (out[2 * i]     + (expand(ad, 1, p[i + 4] & 0x0F) >> 1)) >> 4;
+    out[2 * i + 1] = (out[2 * i + 1] + (expand(ad, 1, p[i + 4] >> 4)   >> 1)) >> 4;
+  }
+  ad->pos += 8;
+}
+
+/*! \brief  Initialize a decoder for a file
+ *
+ *  \param  ad       decoder
+ *  \param  info     format of the file
+ *
+ *  \return 1 on success, 0 if the format is not supported
+ */
+uint8_t adpcm_init(adpcm_t *ad, const wav_info_t *info)
+{
+  if (info->format != WAV_FORMAT_IMA_ADPCM || info->bits != 4 ||
+      info->channels < 1 || info->channels > 2 ||
+      info->block_align <= 4 * info->channels) {
+    return 0;
+  }
+
+  ad->channels = info->channels;
+  ad->group    = info->channels == 1 ? 2 : ADPCM_GROUP;
+  adpcm_begin(ad, 0, 0);
+
+  return 1;
+}
+
+/*! \brief  Get the number of frames in a complete block
+ *
+ *  \param  info     format of the file
+ *
+ *  \return frames per block: the header frame plus two per data byte
+ *          and channel
+ */
+uint16_t adpcm_block_frames(const wav_info_t *info)
+{
+  return (info->block_align - 4 * info->channels) * 2 / info->channels + 1;
+}
+
+/*! \brief  Start decoding a block
+ *
+ *  \param  ad       decoder
+ *  \param  blk      block, must stay valid until adpcm_done() returns 1
+ *  \param  len      bytes in the block, less than block_align for the last
+ *                   block of a file
+ *
+ *  \return void
+ */
+void adpcm_begin(adpcm_t *ad, const uint8_t *blk, uint16_t len)
+{
+  ad->blk   = blk;
+  ad->len   = len < 4 * ad->channels ? 0 : len;   // no room for the header
+  ad->pos   = 0;
+  ad->npend = 0;
+  ad->ppos  = 0;
+}
+
+/*! \brief  Decode frames of the current block
+ *
+ *  \param  ad       decoder
+ *  \param  out      pointer to store the 12-bit DAC codes
+ *  \param  n        maximum number of frames
+ *
+ *  \details An incomplete group at the end of a block is skipped.
+ *
+ *  \return number of frames, less than n if the block is done
+ */
+uint16_t adpcm_decode(adpcm_t *ad, uint16_t *out, uint16_t n)
+{
+  uint16_t  got = 0;
+  uint16_t *dst;
+  uint8_t   bytes = ad->channels == 1 ? 1 : 8;
+
+  CYCLES_BEGIN(t);
+
+  while (got < n) {
+    if (ad->npend) {
+      out[got++] = ad->pend[ad->ppos++];
+      ad->npend--;
+      continue;
+    }
+    if (ad->pos >= ad->len) break;
+    if (ad->pos == 0) {
+      out[got++] = header(ad);
+      continue;
+    }
+    if (ad->pos + bytes > ad->len) {
+      ad->pos = ad->len;
+      break;
+    }
+
+    dst = n - got >= ad->group ? out + got : ad->pend;
+    if (ad->channels == 1) group_mono(ad, dst);
+    else                   group_stereo(ad, dst);
+    if (dst == ad->pend) {
+      ad->npend = ad->group;
+      ad->ppos  = 0;
+    } else {
+      got += ad->group;
+    }
+  }
+
+  ad_samples += got;
+  CYCLES_END(ad_load, t);
+
+  return got;
+}
+
+/*! \brief  Get the cycles spent in adpcm_decode()
+ *
+ *  \param  load     pointer to store the measurement
+ *  \param  samples  pointer to store the number of frames decoded
+ *
+ *  \details The cycles per frame are load->total / *samples. Only measured
+ *           when AUDIO_PROFILE is 1.
+ *
+ *  \return void
+ */
+void adpcm_get_load(cycles_t *load, uint32_t *samples)
+{
+  cycles_get(&ad_load, load);
+  *samples = ad_samples;
+}
@@ -0,0 +1,58 @@
+/*!
+ *  \file    adpcm.h
+ *  \brief   IMA/DVI ADPCM decoder (WAV format tag 0x11)
+ *
+ *  \details An IMA ADPCM file holds 4 bits per sample in blocks of
+ *           block_align bytes. Every block starts with a header per channel
+ *           (first sample, step index) and can be decoded on its own.
+ *           Mono and stereo files are supported; stereo is averaged to mono.
+ *
+ *           Usage per block:
+ *           - read one block and pass it to adpcm_begin();
+ *           - take the 12-bit DAC codes with adpcm_decode() until
+ *             adpcm_done() returns 1.
+ *           .
+ *           The step tables are in flash. With AUDIO_PROFILE set to 1 the
+ *           cycles in adpcm_decode() are measured, see adpcm_get_load().
+ */
+#ifndef ADPCM_H_
+#define ADPCM_H_
+
+#include <stdint.h>
+#include "wav.h"
+#include "cycles.h"
+
+#define ADPCM_GROUP     8       //!< frames per group of 4 bytes per channel (stereo)
+
+/*! \brief  Decoder state */
+typedef struct {
+  int16_t        pred[2];       //!< predicted sample per channel
+  uint8_t        index[2];      //!< step index per channel
+  uint8_t        channels;      //!< 1 or 2
+  uint8_t        group;         //!< frames decoded in one step: 2 (mono) or ADPCM_GROUP
+  const uint8_t *blk;           //!< current block
+  uint16_t       len;           //!< bytes in the current block
+  uint16_t       pos;           //!< next byte in the current block
+  uint8_t        npend;         //!< decoded frames in pend[] not yet taken
+  uint8_t        ppos;          //!< next frame in pend[]
+  uint16_t       pend[ADPCM_GROUP];   //!< group that did not fit in the output
+} adpcm_t;
+
+uint8_t  adpcm_init(adpcm_t *ad, const wav_info_t *info);
+uint16_t adpcm_block_frames(const wav_info_t *info);
+void     adpcm_begin(adpcm_t *ad, const uint8_t *blk, uint16_t len);
+uint16_t adpcm_decode(adpcm_t *ad, uint16_t *out, uint16_t n);
+void     adpcm_get_load(cycles_t *load, uint32_t *samples);
+
+/*! \brief  Test if the current block is completely decoded
+ *
+ *  \param  ad       decoder
+ *
+ *  \return 1 if a new block is needed, 0 otherwise
+ */
+static inline uint8_t adpcm_done(const adpcm_t *ad)
+{
+  return ad->pos >= ad->len && ad->npend == 0;
+}
+
+#endif // ADPCM_H_
@@ -0,0 +1,287 @@
+/*!
+ *  \file    clipindex.c
+ *  \brief   RAM index of the WAV files on the card
+ *
+ *  \details An indexed file is opened by filling in the file object the way
+ *           f_open() does for reading (FatFs R0.15a, FF_FS_EXFAT 0,
+ *           FF_FS_LOCK 0). The hash of the root directory skips the saved
+ *           index itself, so saving it does not change the hash.
+ */
+#include "clipindex.h"
+
+#include <string.h>
+
+static clipindex_entry_t entries[CLIPINDEX_CLIPS];
+static uint8_t           count;                     //!< entries in use
+static FATFS            *vol;                       //!< volume of the indexed files, 0: none
+
+/*! \brief  Continue an FNV-1a hash
+ *
+ *  \param  h        hash so far, 2166136261 at the start
+ *  \param  p        bytes
+ *  \param  n        number of bytes
+ *
+ *  \return hash
+ */
+static uint32_t fnv1a(uint32_t h, const void *p, uint16_t n)
+{
+  const uint8_t *b = p;
+
+  while (n--) {
+    h ^= *b++;
+    h *= 16777619UL;
+  }
+
+  return h;
+}
+
+/*! \brief  Add a file to the index if it is a WAV file the player knows
+ *
+ *  \param  fno      directory entry of the file
+ *
+ *  \return void
+ */
+static void add(const FILINFO *fno)
+{
+  clipindex_entry_t *e = &entries[count];
+  char               path[sizeof(e->name) + 1] = "/";
+  DWORD              clmt[4];
+  FIL                fp;
+
+  strcpy(path + 1, fno->fname);
+  if ( f_open(&fp, path, FA_READ) != FR_OK ) return;
+
+  if ( wav_read_header(&fp, &e->info) == FR_OK ) {
+    fp.cltbl = clmt;                    // one fragment: size, length, cluster, 0
+    clmt[0]  = sizeof(clmt) / sizeof(clmt[0]);
+    e->contiguous = f_lseek(&fp, CREATE_LINKMAP) == FR_OK;
+    e->sclust     = fp.obj.sclust;
+    e->size       = f_size(&fp);
+    strcpy(e->name, fno->fname);
+    vol = fp.obj.fs;
+    count++;
+  }
+  f_close(&fp);
+}
+
+/*! \brief  Hash the root directory and optionally index its WAV files
+ *
+ *  \param  skip     name of the saved index, left out of the hash
+ *  \param  build    1: add the WAV files to the index
+ *  \param  hash     pointer to store the hash
+ *
+ *  \return FR_OK or the FatFs error code
+ */
+static FRESULT scan(const char *skip, uint8_t build, uint32_t *hash)
+{
+  DIR      dir;
+  FILINFO  fno;
+  FRESULT  res;
+  uint32_t h = 2166136261UL;
+  uint8_t  len;
+
+  if ( (res = f_opendir(&dir, "/")) != FR_OK ) {
+    return res;
+  }
+  while ( (res = f_readdir(&dir, &fno)) == FR_OK && fno.fname[0] ) {
+    if (strcasecmp(fno.fname, skip) == 0) continue;
+
+    len = strlen(fno.fname);
+    h = fnv1a(h, fno.fname, len);
+    h = fnv1a(h, &fno.fsize, sizeof(fno.fsize));
+    h = fnv1a(h, &fno.fdate, sizeof(fno.fdate));
+    h = fnv1a(h, &fno.ftime, sizeof(fno.ftime));
+    if ( build && count < CLIPINDEX_CLIPS && !(fno.fattrib & AM_DIR) &&
+         len > 4 && strcasecmp(fno.fname + len - 4, ".WAV") == 0 ) {
+      add(&fno);
+    }
+  }
+  f_closedir(&dir);
+  *hash = h;
+
+  return res;
+}
+
+/*! \brief  Load the saved index if it belongs to this volume
+ *
+ *  \param  path     name of the saved index
+ *  \param  vsn      volume serial number
+ *  \param  hash     hash of the root directory
+ *
+ *  \return 1 if the index was loaded, 0 otherwise
+ */
+static uint8_t load(const char *path, DWORD vsn, uint32_t hash)
+{
+  clipindex_header_t h;
+  FIL                fp;
+  UINT               br;
+  uint16_t           len = 0;
+  uint8_t            ok;
+
+  if ( f_open(&fp, path, FA_READ) != FR_OK ) return 0;
+
+  ok = f_read(&fp, &h, sizeof(h), &br) == FR_OK && br == sizeof(h) &&
+       strncmp(h.magic, "CIDX", 4) == 0 && h.version == CLIPINDEX_VERSION &&
+       h.entry_size == sizeof(clipindex_entry_t) && h.count <= CLIPINDEX_CLIPS &&
+       h.vsn == vsn && h.hash == hash;
+  if (ok) {
+    len = h.count * sizeof(clipindex_entry_t);
+    ok  = f_read(&fp, entries, len, &br) == FR_OK && br == len;
+  }
+  if (ok) {
+    count = h.count;
+    vol   = fp.obj.fs;
+  }
+  f_close(&fp);
+
+  return ok;
+}
+
+/*! \brief  Save the index
+ *
+ *  \param  path     name of the saved index
+ *  \param  vsn      volume serial number
+ *  \param  hash     hash of the root directory
+ *
+ *  \return FR_OK or the FatFs error code
+ */
+static FRESULT save(const char *path, DWORD vsn, uint32_t hash)
+{
+  clipindex_header_t h = { { 'C', 'I', 'D', 'X' }, CLIPINDEX_VERSION, count,
+                           sizeof(clipindex_entry_t), vsn, hash };
+  FIL                fp;
+  UINT               bw;
+  FRESULT            res;
+
+  if ( (res = f_open(&fp, path, FA_WRITE | FA_CREATE_ALWAYS)) != FR_OK ) {
+    return res;
+  }
+  if ( (res = f_write(&fp, &h, sizeof(h), &bw)) == FR_OK ) {
+    res = f_write(&fp, entries, count * sizeof(clipindex_entry_t), &bw);
+  }
+  if (res == FR_OK) {
+    res = f_close(&fp);
+  } else {
+    f_close(&fp);
+  }
+
+  return res;
+}
+
+/*! \brief  Load or make the index of the WAV files in the root directory
+ *
+ *  \param  path     name of the saved index in the root directory
+ *  \param  loaded   pointer to store 1 if the saved index was used and 0 if
+ *                   it was made again, may be 0
+ *
+ *  \details Call this function after f_mount(). Loading costs a scan of the
+ *           root directory; making the index also opens every WAV file and
+ *           reads its header. At most CLIPINDEX_CLIPS files are indexed,
+ *           other files are opened with f_open() as before.
+ *
+ *  \return FR_OK or the FatFs error code. If only the saving failed (for
+ *          example on a write protected card) the index in RAM is used.
+ */
+FRESULT clipindex_mount(const char *path, uint8_t *loaded)
+{
+  const char *name = path[0] == '/' ? path + 1 : path;
+  DWORD       vsn;
+  uint32_t    hash;
+  FRESULT     res;
+
+  clipindex_clear();
+  if (loaded) *loaded = 0;
+  if ( (res = f_getlabel("", 0, &vsn)) != FR_OK ) {
+    return res;
+  }
+  if ( (res = scan(name, 0, &hash)) != FR_OK ) {
+    return res;
+  }
+  if ( load(path, vsn, hash) ) {
+    if (loaded) *loaded = 1;
+    return FR_OK;
+  }
+
+  if ( (res = scan(name, 1, &hash)) != FR_OK ) {
+    clipindex_clear();
+    return res;
+  }
+
+  return save(path, vsn, hash);
+}
+
+/*! \brief  Empty the index, all files are opened with f_open() again
+ *
+ *  \return void
+ */
+void clipindex_clear(void)
+{
+  count = 0;
+  vol   = 0;
+}
+
+/*! \brief  Get the number of indexed files
+ *
+ *  \return number of files
+ */
+uint8_t clipindex_count(void)
+{
+  return count;
+}
+
+/*! \brief  Look up a file
+ *
+ *  \param  name     name of the file in the root directory, with or
+ *                   without a leading '/', any case
+ *
+ *  \return pointer to the entry, 0 if the file is not indexed
+ */
+const clipindex_entry_t *clipindex_find(const char *name)
+{
+  uint8_t i;
+
+  if (name[0] == '/') name++;
+  for (i = 0; i < count; i++) {
+    if (strcasecmp(entries[i].name, name) == 0) return &entries[i];
+  }
+
+  return 0;
+}
+
+/*! \brief  Open an indexed file at its first sample
+ *
+ *  \param  fp       file object to use
+ *  \param  e        entry from clipindex_find()
+ *  \param  clmt     4 DWORDs for the cluster link map table of a contiguous
+ *                   file, must stay valid while the file is open; may be 0
+ *
+ *  \details No sector is read: the file object is filled in from the entry
+ *           and the read pointer is set to the data chunk. The file can be
+ *           read, positioned and closed with FatFs as usual.
+ *
+ *  \return FR_OK, FR_NOT_ENABLED if the volume is no longer mounted or the
+ *          FatFs error code
+ */
+FRESULT clipindex_open(FIL *fp, const clipindex_entry_t *e, DWORD *clmt)
+{
+  DWORD bytes;
+
+  if ( !vol || !vol->fs_type ) return FR_NOT_ENABLED;
+
+  memset(fp, 0, sizeof(*fp));
+  fp->obj.fs      = vol;
+  fp->obj.id      = vol->id;
+  fp->obj.sclust  = e->sclust;
+  fp->obj.objsize = e->size;
+  fp->flag        = FA_READ;
+  if (e->contiguous && clmt) {          // one fragment: size, length, cluster, 0
+    bytes   = (DWORD) vol->csize * FF_MAX_SS;
+    clmt[0] = 4;
+    clmt[1] = (e->size + bytes - 1) / bytes;
+    clmt[2] = e->sclust;
+    clmt[3] = 0;
+    fp->cltbl = clmt;
+  }
+
+  return f_lseek(fp, e->info.data_offset);
+}
@@ -0,0 +1,59 @@
+/*!
+ *  \file    clipindex.h
+ *  \brief   RAM index of the WAV files on the card
+ *
+ *  \details clipindex_mount() makes an index of the WAV files in the root
+ *           directory: the start cluster and the size of every file, the
+ *           format and the place of its data chunk, and whether the file is
+ *           contiguous. The player looks a file up here before it calls
+ *           f_open(): an indexed file is opened without reading a directory
+ *           sector and without reading its header. Contiguous files get a
+ *           cluster link map table, so streaming them reads no FAT sectors
+ *           either.
+ *
+ *           The index is saved in a file on the card together with the
+ *           volume serial number and a hash of the root directory (names,
+ *           sizes, dates and times). At the next boot it is loaded again if
+ *           both are unchanged; otherwise it is made again. Call
+ *           clipindex_clear() or clipindex_mount() again after writing to
+ *           the files that are indexed.
+ */
+#ifndef CLIPINDEX_H_
+#define CLIPINDEX_H_
+
+#include <stdint.h>
+#include "../ff/ff.h"
+#include "wav.h"
+
+#ifndef CLIPINDEX_CLIPS
+#define CLIPINDEX_CLIPS     12      //!< files kept in the index
+#endif
+
+#define CLIPINDEX_VERSION   1       //!< version of the saved index
+
+/*! \brief  One indexed file */
+typedef struct {
+  char       name[13];          //!< 8.3 name as in the directory, upper case
+  uint8_t    contiguous;        //!< 1: the clusters of the file are contiguous
+  DWORD      sclust;            //!< first cluster
+  FSIZE_t    size;              //!< bytes of the file
+  wav_info_t info;              //!< format and place of the data chunk
+} clipindex_entry_t;
+
+/*! \brief  Start of the saved index, followed by the entries */
+typedef struct {
+  char     magic[4];            //!< "CIDX"
+  uint8_t  version;             //!< CLIPINDEX_VERSION
+  uint8_t  count;               //!< number of entries
+  uint16_t entry_size;          //!< sizeof(clipindex_entry_t)
+  uint32_t vsn;                 //!< volume serial number
+  uint32_t hash;                //!< FNV-1a hash of the root directory
+} clipindex_header_t;
+
+FRESULT  clipindex_mount(const char *path, uint8_t *loaded);
+void     clipindex_clear(void);
+uint8_t  clipindex_count(void);
+const clipindex_entry_t *clipindex_find(const char *name);
+FRESULT  clipindex_open(FIL *fp, const clipindex_entry_t *e, DWORD *clmt);
+
+#endif // CLIPINDEX_H_
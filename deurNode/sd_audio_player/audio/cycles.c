@@ -0,0 +1,61 @@
+/*!
+ *  \file    cycles.c
+ *  \brief   CPU cycle measurements for the audio path
+ */
+#include "cycles.h"
+
+#include <util/atomic.h>
+
+/*! \brief  Start TCD0 as a free running counter at the system clock
+ *
+ *  \return void
+ */
+void cycles_init(void)
+{
+  TCD0.CTRLB = TC_WGMODE_NORMAL_gc;
+  TCD0.PER   = 0xFFFF;
+  TCD0.CTRLA = TC_CLKSEL_DIV1_gc;
+}
+
+/*! \brief  Add one measurement
+ *
+ *  \param  c        measured section
+ *  \param  n        cycles of this run
+ *
+ *  \return void
+ */
+void cycles_add(cycles_t *c, uint16_t n)
+{
+  c->total += n;
+  c->count++;
+  if (n > c->max) c->max = n;
+}
+
+/*! \brief  Copy a measurement that is updated in an interrupt
+ *
+ *  \param  c        measured section
+ *  \param  copy     pointer to store the copy
+ *
+ *  \return void
+ */
+void cycles_get(const cycles_t *c, cycles_t *copy)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    *copy = *c;
+  }
+}
+
+/*! \brief  Clear a measurement
+ *
+ *  \param  c        measured section
+ *
+ *  \return void
+ */
+void cycles_clear(cycles_t *c)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    c->total = 0;
+    c->max   = 0;
+    c->count = 0;
+  }
+}
@@ -0,0 +1,64 @@
+/*!
+ *  \file    cycles.h
+ *  \brief   CPU cycle measurements for the audio path
+ *
+ *  \details TCD0 runs free at the system clock, so a difference of two
+ *           cycles_now() readings is the number of CPU cycles between them
+ *           (up to 65535). The measurements are only compiled in when
+ *           AUDIO_PROFILE is 1.
+ *
+ *           Read TCD0.CNT only through cycles_now(). The 16-bit read goes
+ *           through the TEMP register of TCD0, which an interrupt between
+ *           the low and the high byte would overwrite with its own read, so
+ *           cycles_now() reads with interrupts disabled. That also holds in
+ *           interrupts, which a higher level can interrupt.
+ */
+#ifndef CYCLES_H_
+#define CYCLES_H_
+
+#include <stdint.h>
+#include <avr/io.h>
+#include <util/atomic.h>
+
+#ifndef AUDIO_PROFILE
+#define AUDIO_PROFILE   0       //!< 1: measure cycles in the audio path
+#endif
+
+/*! \brief  Accumulated cycles of one measured code section */
+typedef struct {
+  uint32_t total;               //!< sum of all measured cycles
+  uint16_t max;                 //!< longest single run
+  uint16_t count;               //!< number of runs
+} cycles_t;
+
+void cycles_init(void);
+void cycles_add(cycles_t *c, uint16_t n);
+void cycles_get(const cycles_t *c, cycles_t *copy);
+void cycles_clear(cycles_t *c);
+
+/*! \brief  Read the free running cycle counter
+ *
+ *  \details Interrupts are disabled for the two byte reads only.
+ *
+ *  \return current value of TCD0
+ */
+static inline uint16_t cycles_now(void)
+{
+  uint16_t t;
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    t = TCD0.CNT;
+  }
+
+  return t;
+}
+
+#if AUDIO_PROFILE
+#define CYCLES_BEGIN(t)         uint16_t t = cycles_now()                   //!< start a measurement
+#define CYCLES_END(c, t)        cycles_add(&(c), cycles_now() - (t))        //!< add the cycles since CYCLES_BEGIN
+#else
+#define CYCLES_BEGIN(t)
+#define CYCLES_END(c, t)
+#endif
+
+#endif // CYCLES_H_
@@ -0,0 +1,224 @@
+/*!
+ *  \file    dac.c
+ *  \brief   Audio output on DACB channel 0, paced by TCC0
+ *
+ *  \details In DMA mode DMA channel 0 and 1 are used as a double buffered
+ *           pair. When one channel has moved its block the other one takes
+ *           over without CPU help, and the block interrupt of the finished
+ *           channel gives the block back to the player and loads the next
+ *           one. The sample clock is stepped once per block, see
+ *           sampleclock.h. Because the DAC converts on the same event that triggers
+ *           the DMA, the output is not delayed by interrupt latency.
+ *
+ *           With AUDIO_PROFILE set to 1 the cycles spent in the output
+ *           interrupts are measured, see dac_get_load(). The measurement runs
+ *           from the first to the last statement of the interrupt; the
+ *           prologue and epilogue generated by the compiler are not included.
+ */
+#include "dac.h"
+#include "player.h"
+#include "sampleclock.h"
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/delay.h>
+
+#define RAMP_STEPS      64      //!< steps of a DAC ramp
+
+static uint8_t  out_mode = DAC_OUT_ISR;
+static cycles_t out_load;                 //!< cycles in the output interrupts
+
+/*! \brief  Move the DAC output slowly to a level
+ *
+ *  \param  to       12-bit DAC code
+ *
+ *  \details The output changes in RAMP_STEPS steps in DAC_RAMP_US
+ *           microseconds. The conversions are started by the writes, so the
+ *           sample clock must not run.
+ *
+ *  \return void
+ */
+static void ramp(uint16_t to)
+{
+  int16_t from = DACB.CH0DATA;
+  uint8_t i;
+
+  DACB.CTRLB = DAC_CHSEL_SINGLE_gc;     // convert on every write
+  for (i = 1; i <= RAMP_STEPS; i++) {
+    DACB.CH0DATA = from + (int16_t) ((int32_t) ((int16_t) to - from) * i / RAMP_STEPS);
+    _delay_us(DAC_RAMP_US / RAMP_STEPS);
+  }
+  if (out_mode == DAC_OUT_DMA) {
+    DACB.CTRLB = DAC_CHSEL_SINGLE_gc | DAC_CH0TRIG_bm;
+  }
+}
+
+/*! \brief  Initialize DACB channel 0
+ *
+ *  \param  mode     DAC_OUT_ISR or DAC_OUT_DMA
+ *
+ *  \details In DMA mode the conversion is started by event channel 0, so
+ *           the DAC output changes exactly at the TCC0 overflow. The output
+ *           ramps from 0 to mid-scale, so the speaker does not click at
+ *           power-up.
+ *
+ *  \return void
+ */
+void init_dac(uint8_t mode)
+{
+  out_mode = mode;
+
+  DACB.CTRLC = DAC_REFSEL_AVCC_gc;
+  if (mode == DAC_OUT_DMA) {
+    DACB.EVCTRL = DAC_EVSEL_0_gc;                       // conversion on event channel 0
+  }
+  DACB.CTRLB   = DAC_CHSEL_SINGLE_gc;
+  DACB.CH0DATA = 0;
+  DACB.CTRLA   = DAC_CH0EN_bm | DAC_ENABLE_bm;
+  ramp(DAC_MID);
+}
+
+/*! \brief  Initialize TCC0 as sample clock
+ *
+ *  \param  mode     DAC_OUT_ISR or DAC_OUT_DMA
+ *
+ *  \details In ISR mode the overflow interrupt is enabled. In DMA mode the
+ *           overflow is routed to event channel 0 and DMA channel 0 and 1 are
+ *           configured. The rate is 16 kHz until it is changed with
+ *           sampleclock_set(). The timer is started by dac_start().
+ *
+ *  \return void
+ */
+void timer_init(uint8_t mode)
+{
+  TCC0.CTRLA = TC_CLKSEL_OFF_gc;
+  TCC0.CNT   = 0;
+  sampleclock_set(16000);               // Stel periode in voor 16 kHz
+  TCC0.CTRLB = TC_WGMODE_NORMAL_gc;     // Normale mode
+
+  if (mode == DAC_OUT_DMA) {
+    TCC0.INTCTRLA = TC_OVFINTLVL_OFF_gc;
+    EVSYS.CH0MUX  = EVSYS_CHMUX_TCC0_OVF_gc;
+
+    DMA.CTRL = 0;
+    DMA.CTRL = DMA_RESET_bm;
+    while (DMA.CTRL & DMA_RESET_bm) ;
+
+    DMA.CH0.ADDRCTRL  = DMA_CH_SRCRELOAD_NONE_gc | DMA_CH_SRCDIR_INC_gc |
+                        DMA_CH_DESTRELOAD_BURST_gc | DMA_CH_DESTDIR_INC_gc;
+    DMA.CH0.TRIGSRC   = DMA_CH_TRIGSRC_EVSYS_CH0_gc;
+    DMA.CH0.DESTADDR0 = (uint8_t) ((uint16_t) &DACB.CH0DATA);
+    DMA.CH0.DESTADDR1 = (uint8_t) ((uint16_t) &DACB.CH0DATA >> 8);
+    DMA.CH0.DESTADDR2 = 0;
+    DMA.CH0.CTRLB     = DMA_CH_TRNINTLVL_LO_gc;
+
+    DMA.CH1.ADDRCTRL  = DMA.CH0.ADDRCTRL;
+    DMA.CH1.TRIGSRC   = DMA.CH0.TRIGSRC;
+    DMA.CH1.DESTADDR0 = DMA.CH0.DESTADDR0;
+    DMA.CH1.DESTADDR1 = DMA.CH0.DESTADDR1;
+    DMA.CH1.DESTADDR2 = 0;
+    DMA.CH1.CTRLB     = DMA_CH_TRNINTLVL_LO_gc;
+
+    DMA.CTRL = DMA_ENABLE_bm | DMA_DBUFMODE_CH01_gc | DMA_PRIMODE_CH0123_gc;
+  } else {
+    TCC0.INTCTRLA = TC_OVFINTLVL_LO_gc; // Interrupt bij overflow
+  }
+
+  PMIC.CTRL |= PMIC_LOLVLEN_bm;         // Zet Low Level Interrupts aan
+}
+
+/*! \brief  Load the next player block in a DMA channel
+ *
+ *  \param  ch       DMA channel 0 or 1
+ *
+ *  \return void
+ */
+static void dma_load(DMA_CH_t *ch)
+{
+  const uint16_t *src;
+  uint16_t        len;
+
+  src = player_claim_block(&len);
+  ch->SRCADDR0 = (uint8_t) ((uint16_t) src);
+  ch->SRCADDR1 = (uint8_t) ((uint16_t) src >> 8);
+  ch->SRCADDR2 = 0;
+  ch->TRFCNT   = len * sizeof(uint16_t);
+}
+
+/*! \brief  Start the output. Call this function after player_open().
+ *
+ *  \return void
+ */
+void dac_start(void)
+{
+  if (out_mode == DAC_OUT_DMA) {
+    dma_load(&DMA.CH0);
+    dma_load(&DMA.CH1);
+    DMA.CH1.CTRLA = DMA_CH_SINGLE_bm | DMA_CH_BURSTLEN_2BYTE_gc;
+    DMA.CH0.CTRLA = DMA_CH_ENABLE_bm | DMA_CH_SINGLE_bm | DMA_CH_BURSTLEN_2BYTE_gc;
+  }
+  TCC0.CNT   = 0;
+  TCC0.CTRLA = TC_CLKSEL_DIV1_gc;
+}
+
+/*! \brief  Stop the output and ramp the DAC to mid-scale
+ *
+ *  \details After player_service() has returned 0 the output is already at
+ *           mid-scale. When the output is stopped during playback the ramp
+ *           starts at the last sample, so there is no step.
+ *
+ *  \return void
+ */
+void dac_stop(void)
+{
+  TCC0.CTRLA = TC_CLKSEL_OFF_gc;
+  if (out_mode == DAC_OUT_DMA) {
+    DMA.CH0.CTRLA = 0;
+    DMA.CH1.CTRLA = 0;
+    DMA.CH0.CTRLB = DMA_CH_TRNIF_bm | DMA_CH_ERRIF_bm | DMA_CH_TRNINTLVL_LO_gc;
+    DMA.CH1.CTRLB = DMA_CH_TRNIF_bm | DMA_CH_ERRIF_bm | DMA_CH_TRNINTLVL_LO_gc;
+  }
+  ramp(DAC_MID);
+}
+
+/*! \brief  Get the cycles spent in the output interrupts
+ *
+ *  \param  load     pointer to store the measurement
+ *
+ *  \details Only measured when AUDIO_PROFILE is 1. In ISR mode there is one
+ *           run per sample, in DMA mode one run per block.
+ *
+ *  \return void
+ */
+void dac_get_load(cycles_t *load)
+{
+  cycles_get(&out_load, load);
+}
+
+ISR(TCC0_OVF_vect)
+{
+  CYCLES_BEGIN(t);
+  DACB.CH0DATA = player_next_sample();
+  sampleclock_step();
+  CYCLES_END(out_load, t);
+}
+
+ISR(DMA_CH0_vect)
+{
+  CYCLES_BEGIN(t);
+  DMA.CH0.CTRLB = DMA_CH_TRNIF_bm | DMA_CH_TRNINTLVL_LO_gc;
+  player_release_block();
+  dma_load(&DMA.CH0);                   // enabled again when CH1 is done
+  sampleclock_step();                   // period for the next block
+  CYCLES_END(out_load, t);
+}
+
+ISR(DMA_CH1_vect)
+{
+  CYCLES_BEGIN(t);
+  DMA.CH1.CTRLB = DMA_CH_TRNIF_bm | DMA_CH_TRNINTLVL_LO_gc;
+  player_release_block();
+  dma_load(&DMA.CH1);                   // enabled again when CH0 is done
+  sampleclock_step();                   // period for the next block
+  CYCLES_END(out_load, t);
+}
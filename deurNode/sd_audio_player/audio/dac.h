@@ -0,0 +1,33 @@
+/*!
+ *  \file    dac.h
+ *  \brief   Audio output on DACB channel 0, paced by TCC0
+ *
+ *  \details Two output modes are available:
+ *           - DAC_OUT_ISR: the TCC0 overflow interrupt writes every sample;
+ *           - DAC_OUT_DMA: the TCC0 overflow is routed to event channel 0.
+ *             The event starts the DAC conversion and triggers DMA channel 0
+ *             or 1, which move the next sample from a player buffer to
+ *             DACB.CH0DATA. The CPU only gets an interrupt per block.
+ *           .
+ *           The mode is passed to init_dac() and timer_init().
+ */
+#ifndef DAC_H_
+#define DAC_H_
+
+#include <stdint.h>
+#include "cycles.h"
+
+#define DAC_OUT_ISR     0       //!< one interrupt per sample
+#define DAC_OUT_DMA     1       //!< one interrupt per block, samples moved by DMA
+
+#ifndef DAC_RAMP_US
+#define DAC_RAMP_US     8000    //!< duration of the ramp to mid-scale at init and stop
+#endif
+
+void init_dac(uint8_t mode);
+void timer_init(uint8_t mode);
+void dac_start(void);
+void dac_stop(void);
+void dac_get_load(cycles_t *load);
+
+#endif // DAC_H_
@@ -0,0 +1,122 @@
+/*!
+ *  \file    flashbank.c
+ *  \brief   Read-only sound bank in program flash
+ *
+ *  \details flashbank_data.h defines FLASHBANK_RATE, FLASHBANK_CLIPS, the
+ *           index flashbank_index[], an array per clip and flashbank_addr(),
+ *           which returns the far address of a clip.
+ */
+#include "flashbank.h"
+
+#include <string.h>
+#include <avr/pgmspace.h>
+
+#include "flashbank_data.h"
+
+/*! \brief  Get the number of clips in the bank
+ *
+ *  \return number of clips
+ */
+uint8_t flashbank_count(void)
+{
+  return FLASHBANK_CLIPS;
+}
+
+/*! \brief  Get the sample rate of the bank
+ *
+ *  \return samples per second of all clips
+ */
+uint16_t flashbank_rate(void)
+{
+  return FLASHBANK_RATE;
+}
+
+/*! \brief  Read an index entry
+ *
+ *  \param  index    0 .. FLASHBANK_CLIPS-1
+ *  \param  e        pointer to store the entry
+ *
+ *  \return void
+ */
+static void read_entry(uint8_t index, flashbank_entry_t *e)
+{
+  memcpy_PF(e, pgm_get_far_address(flashbank_index) + (uint32_t) index * sizeof(*e), sizeof(*e));
+}
+
+/*! \brief  Look up a clip by name
+ *
+ *  \param  name     file name without extension, lower case
+ *
+ *  \return index of the clip, FLASHBANK_NONE if it is not in the bank
+ */
+uint8_t flashbank_find(const char *name)
+{
+  flashbank_entry_t e;
+  uint8_t           i;
+
+  for (i = 0; i < FLASHBANK_CLIPS; i++) {
+    read_entry(i, &e);
+    if (strncmp(e.name, name, FLASHBANK_NAME) == 0) return i;
+  }
+
+  return FLASHBANK_NONE;
+}
+
+/*! \brief  Prepare a clip for playing
+ *
+ *  \param  clip     clip state
+ *  \param  index    0 .. FLASHBANK_CLIPS-1, see flashbank_find()
+ *
+ *  \return 1 on success, 0 for an invalid index
+ */
+uint8_t flashbank_open(flashbank_clip_t *clip, uint8_t index)
+{
+  flashbank_entry_t e;
+  wav_info_t        info;
+
+  if (index >= FLASHBANK_CLIPS) return 0;
+
+  read_entry(index, &e);
+  clip->addr = flashbank_addr(index);
+  clip->left = e.length;
+
+  info.format      = WAV_FORMAT_PCM;
+  info.channels    = 1;
+  info.sample_rate = FLASHBANK_RATE;
+  info.block_align = 1;
+  info.bits        = 8;
+  info.data_offset = 0;
+  info.data_size   = e.length;
+  info.loop_start  = 0;
+  info.loop_end    = 0;
+
+  return pcm_select(&clip->dec, &info);
+}
+
+/*! \brief  Mixer source that plays a clip from flash
+ *
+ *  \param  ctx      pointer to a flashbank_clip_t
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples wanted
+ *
+ *  \details The bytes are copied to the upper half of dst and widened from
+ *           the start; every byte is read before its place is written.
+ *
+ *  \return number of samples made, less than n at the end of the clip
+ */
+uint16_t flashbank_source(void *ctx, uint16_t *dst, uint16_t n)
+{
+  flashbank_clip_t *clip = ctx;
+  uint8_t          *raw;
+
+  if (n > clip->left) n = clip->left;
+  if (n == 0) return 0;
+
+  raw = (uint8_t *) dst + n;
+  memcpy_PF(raw, clip->addr, n);
+  pcm_decode(&clip->dec, raw, dst, n);
+  clip->addr += n;
+  clip->left -= n;
+
+  return n;
+}
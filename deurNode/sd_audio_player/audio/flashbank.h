@@ -0,0 +1,48 @@
+/*!
+ *  \file    flashbank.h
+ *  \brief   Read-only sound bank in program flash
+ *
+ *  \details Essential clips (door chime, error beep) are kept in flash, so
+ *           they play without an SD-card and start without waiting for it.
+ *           The bank is made on the PC from a folder of WAV files by
+ *           tools/mkflashbank.c, which writes audio/flashbank_data.h: an
+ *           array of 8-bit unsigned mono samples per clip, all at one rate,
+ *           and an index with the name and length of every clip.
+ *
+ *           The bank may be larger than 64 KB and may lie above the first
+ *           64 KB of flash, so it is read with far addresses (ELPM): the
+ *           samples of a block are copied with memcpy_PF() and widened to
+ *           12-bit DAC codes in place by the PCM kernel (pcm.h).
+ *
+ *           flashbank_source() is a mixer source (mixer.h); see also
+ *           player_flash().
+ */
+#ifndef FLASHBANK_H_
+#define FLASHBANK_H_
+
+#include <stdint.h>
+#include "pcm.h"
+
+#define FLASHBANK_NAME  12      //!< bytes of a clip name, including the 0
+#define FLASHBANK_NONE  0xFF    //!< no clip
+
+/*! \brief  Index entry of a clip, as stored in flash */
+typedef struct {
+  char     name[FLASHBANK_NAME];    //!< file name without extension, lower case
+  uint16_t length;                  //!< number of samples
+} flashbank_entry_t;
+
+/*! \brief  A clip being played */
+typedef struct {
+  uint32_t      addr;           //!< far flash address of the next sample
+  uint32_t      left;           //!< samples not yet played
+  pcm_decoder_t dec;            //!< kernel for 8-bit mono
+} flashbank_clip_t;
+
+uint8_t  flashbank_count(void);
+uint16_t flashbank_rate(void);
+uint8_t  flashbank_find(const char *name);
+uint8_t  flashbank_open(flashbank_clip_t *clip, uint8_t index);
+uint16_t flashbank_source(void *ctx, uint16_t *dst, uint16_t n);
+
+#endif // FLASHBANK_H_
@@ -0,0 +1,632 @@
+/*!
+ *  \file    flashbank_data.h
+ *  \brief   Sound bank at 16000 Hz made from flash/
+ *
+ *  \details Generated by tools/mkflashbank.c, do not edit.
+ */
+#ifndef FLASHBANK_DATA_H_
+#define FLASHBANK_DATA_H_
+
+#include <avr/pgmspace.h>
+
+#define FLASHBANK_RATE   16000   //!< rate of all clips
+#define FLASHBANK_CLIPS  1       //!< number of clips
+
+static const uint8_t flashbank_clip0[9600] PROGMEM = {   // Chime
+  128,129,132,135,137,137,137,136,135,135,135,132,129,124,120,116,
+  114,110,104, 95, 86, 81, 84, 98,121,148,171,186,190,184,174,165,
+  159,156,152,144,133,120,108,100, 94, 88, 78, 64, 48, 40, 45, 68,
+  105,148,186,210,216,208,193,179,168,162,157,150,138,123,110,101,
+   95, 90, 82, 68, 53, 42, 43, 60, 94,136,176,204,215,211,197,182,
+  170,163,159,152,141,127,114,103, 97, 92, 85, 73, 58, 45, 42, 55,
+   84,125,166,198,213,212,200,185,172,165,160,154,144,131,117,106,
+   99, 94, 88, 77, 62, 48, 42, 50, 75,113,155,190,210,213,204,189,
+  175,166,161,155,147,135,121,109,100, 95, 90, 81, 67, 52, 43, 47,
+   67,102,144,181,206,213,206,192,178,168,162,157,149,138,125,112,
+  103, 97, 92, 84, 72, 57, 45, 45, 61, 92,133,172,200,212,209,196,
+  181,169,163,158,152,142,128,115,105, 98, 94, 87, 76, 61, 48, 44,
+   56, 83,121,162,193,210,210,199,184,172,164,159,153,144,132,119,
+  107,100, 95, 90, 80, 66, 52, 45, 52, 75,111,151,185,206,210,202,
+  188,174,165,160,155,147,136,122,110,102, 97, 92, 83, 71, 56, 47,
+   49, 67,100,140,177,201,210,204,191,177,167,161,156,149,139,126,
+  113,104, 98, 94, 87, 75, 60, 49, 48, 61, 91,129,167,196,209,206,
+  194,180,169,162,157,151,142,129,116,106,100, 95, 89, 79, 65, 52,
+   47, 57, 82,118,157,189,206,207,198,183,171,163,158,153,145,133,
+  120,109,102, 97, 92, 83, 69, 56, 48, 53, 74,108,147,181,202,208,
+  200,187,173,164,159,154,147,136,123,112,103, 98, 94, 86, 74, 60,
+   50, 51, 68, 98,137,173,198,207,203,190,176,166,160,156,149,139,
+  127,115,105,100, 95, 89, 78, 64, 52, 50, 62, 89,126,163,192,205,
+  204,193,179,168,161,157,151,142,130,118,108,101, 97, 91, 82, 68,
+   56, 50, 58, 81,116,154,185,202,205,196,182,170,162,157,153,145,
+  134,121,110,103, 98, 93, 85, 73, 59, 51, 55, 74,106,143,177,199,
+  205,199,186,173,164,158,154,147,137,125,113,105,100, 95, 88, 77,
+   63, 53, 53, 68, 97,133,169,194,204,201,189,176,165,159,155,149,
+  140,128,116,107,101, 97, 91, 81, 67, 56, 53, 63, 88,123,159,188,
+  202,202,192,178,167,160,156,151,143,131,119,109,103, 98, 93, 84,
+   72, 59, 53, 59, 81,113,150,181,199,203,195,182,169,161,157,152,
+  145,134,122,112,104,100, 95, 87, 76, 63, 54, 57, 74,104,140,173,
+  195,202,197,185,172,163,158,153,147,138,126,114,106,101, 97, 90,
+   80, 66, 56, 55, 68, 95,130,165,190,201,199,188,175,165,158,154,
+  149,140,129,117,108,102, 98, 93, 83, 71, 59, 55, 64, 87,120,156,
+  184,199,200,191,178,167,159,155,150,143,132,120,110,104,100, 95,
+   87, 75, 62, 56, 61, 80,111,146,177,196,200,193,181,169,161,156,
+  152,145,135,123,113,106,101, 97, 90, 79, 66, 57, 59, 74,102,137,
+  169,191,200,195,184,171,162,157,153,147,138,127,116,107,102, 98,
+   92, 82, 70, 59, 58, 69, 94,127,161,186,198,197,187,174,164,158,
+  154,149,141,130,118,109,104,100, 95, 86, 74, 62, 58, 65, 86,118,
+  152,180,196,198,189,177,166,159,154,150,143,133,121,112,105,101,
+   97, 89, 77, 65, 58, 62, 80,109,143,173,192,198,192,180,168,160,
+  155,151,145,136,125,114,107,102, 98, 92, 81, 69, 60, 61, 74,101,
+  134,165,188,197,193,183,171,162,156,152,147,138,128,117,109,104,
+  100, 94, 85, 73, 62, 60, 70, 93,125,157,183,195,195,185,173,163,
+  157,153,148,141,131,120,111,105,101, 96, 88, 77, 65, 60, 66, 86,
+  116,149,176,193,195,188,176,165,158,154,150,143,134,123,113,106,
+  102, 98, 91, 80, 68, 61, 64, 80,107,140,170,189,195,190,179,168,
+  159,155,151,145,136,126,115,108,103,100, 94, 84, 72, 63, 62, 75,
+   99,131,162,184,194,192,182,170,161,155,152,147,139,128,118,110,
+  105,101, 96, 87, 76, 65, 62, 71, 92,122,154,179,192,193,184,173,
+  163,156,152,148,141,131,121,112,106,102, 98, 90, 79, 68, 63, 67,
+   85,114,146,173,189,193,187,175,165,157,153,149,143,134,124,114,
+  108,103,100, 93, 83, 71, 64, 65, 80,105,137,166,186,193,189,178,
+  167,159,154,150,145,137,126,117,109,105,101, 95, 86, 75, 66, 64,
+   75, 98,128,159,181,192,190,181,169,160,155,151,147,139,129,119,
+  111,106,102, 98, 89, 78, 68, 64, 71, 91,120,151,176,189,191,183,
+  172,162,156,152,148,141,132,122,113,107,103, 99, 92, 82, 71, 65,
+   69, 85,112,142,170,186,191,185,175,164,157,153,149,143,135,125,
+  115,109,105,101, 95, 85, 74, 66, 67, 80,104,134,163,183,190,187,
+  177,166,158,153,150,145,137,127,118,110,106,102, 97, 89, 78, 68,
+   66, 76, 97,126,155,178,189,188,180,169,160,154,151,146,139,130,
+  120,112,107,103, 99, 92, 81, 71, 67, 72, 91,118,148,172,187,189,
+  182,171,161,155,151,148,142,133,123,114,108,105,101, 94, 84, 74,
+   67, 70, 85,110,140,166,183,189,184,174,163,156,152,149,143,135,
+  125,116,110,106,102, 97, 88, 77, 69, 69, 80,103,132,159,180,188,
+  185,176,166,158,153,149,145,138,128,119,111,107,104, 99, 91, 80,
+   71, 68, 76, 96,124,152,175,186,186,179,168,159,154,150,146,140,
+  131,121,113,108,105,101, 94, 84, 74, 69, 74, 90,116,145,169,184,
+  187,181,170,161,154,151,147,142,133,124,115,109,106,102, 96, 87,
+   77, 70, 72, 85,108,137,163,181,187,183,173,163,156,151,148,143,
+  136,126,117,111,107,103, 98, 90, 80, 71, 71, 81,102,129,156,177,
+  186,184,175,165,157,152,149,145,138,129,120,112,108,105,100, 93,
+   83, 74, 70, 77, 95,121,149,172,184,185,178,167,159,153,150,146,
+  140,131,122,114,109,106,102, 95, 86, 76, 71, 75, 90,114,142,166,
+  181,185,180,170,160,154,150,147,142,134,125,116,110,107,103, 98,
+   89, 79, 72, 73, 85,107,134,160,178,184,181,172,162,155,151,148,
+  143,136,127,118,112,108,105,100, 92, 82, 74, 72, 81,101,127,153,
+  174,183,182,174,165,156,152,148,144,138,130,121,113,109,106,102,
+   95, 85, 76, 72, 78, 95,120,146,169,181,183,177,167,158,152,149,
+  146,140,132,123,115,110,107,103, 97, 88, 79, 73, 76, 90,112,139,
+  163,179,183,178,169,160,153,150,146,142,134,125,117,111,108,105,
+   99, 91, 82, 74, 75, 85,106,132,157,175,182,180,171,162,155,150,
+  147,143,136,128,119,113,109,106,101, 94, 85, 76, 74, 82,100,125,
+  151,171,181,181,174,164,156,151,148,144,138,130,122,114,110,107,
+  103, 97, 88, 79, 74, 79, 94,118,144,166,179,181,175,166,158,152,
+  148,145,140,133,124,116,111,108,104, 99, 91, 81, 75, 77, 90,111,
+  137,160,176,181,177,168,159,153,149,146,142,135,126,118,112,109,
+  106,101, 93, 84, 77, 76, 86,105,130,154,172,180,178,171,161,154,
+  150,147,143,137,129,120,114,110,107,103, 96, 87, 79, 76, 82, 99,
+  123,148,168,179,179,173,163,155,150,147,144,139,131,122,115,111,
+  108,104, 98, 90, 81, 76, 80, 94,116,141,163,176,179,174,166,157,
+  151,148,145,140,133,125,117,112,109,106,101, 93, 84, 77, 79, 90,
+  110,135,158,173,179,176,168,159,152,149,146,142,135,127,119,113,
+  110,107,102, 95, 86, 79, 78, 86,104,128,152,170,178,177,170,161,
+  154,149,146,143,137,129,121,115,111,108,104, 98, 89, 81, 78, 83,
+   98,121,145,165,176,178,172,163,155,150,147,144,139,131,123,116,
+  112,109,105,100, 92, 83, 78, 81, 94,115,139,160,174,178,173,165,
+  157,151,147,145,140,133,125,118,113,110,107,102, 95, 86, 79, 80,
+   90,109,132,155,171,177,175,167,158,152,148,145,141,135,128,120,
+  114,110,108,104, 97, 88, 81, 79, 87,103,126,149,167,176,176,169,
+  160,153,149,146,143,137,130,122,116,111,109,105, 99, 91, 83, 79,
+   84, 98,119,143,163,174,176,171,162,155,149,146,143,139,132,124,
+  117,113,110,107,102, 94, 85, 80, 82, 94,113,137,158,172,176,172,
+  164,156,150,147,144,140,134,126,119,114,110,108,103, 96, 88, 81,
+   81, 90,108,130,152,168,175,173,166,158,151,148,145,141,136,128,
+  121,115,111,109,105, 99, 91, 83, 81, 87,102,124,147,165,174,174,
+  168,160,153,148,145,142,137,130,123,116,112,110,106,101, 93, 85,
+   81, 85, 98,118,141,160,172,175,170,162,154,149,146,143,139,132,
+  125,118,113,110,108,103, 96, 88, 82, 83, 94,112,135,155,169,174,
+  171,164,156,150,146,144,140,134,127,120,115,111,109,105, 98, 90,
+   83, 83, 90,107,128,150,166,173,172,166,157,151,147,144,141,136,
+  129,122,116,112,110,106,100, 93, 85, 83, 88,102,122,144,162,172,
+  173,167,159,152,148,145,142,137,131,124,117,113,110,108,102, 95,
+   87, 83, 86, 98,117,139,158,170,173,169,161,154,149,146,143,139,
+  133,125,119,114,111,109,104, 97, 90, 84, 85, 94,111,133,153,167,
+  173,170,163,155,149,146,144,140,135,127,121,115,112,110,106,100,
+   92, 85, 84, 91,106,127,148,164,172,171,165,157,151,147,144,141,
+  136,129,122,117,113,110,107,102, 94, 87, 84, 88,101,121,142,160,
+  170,171,166,159,152,147,145,142,138,131,124,118,114,111,109,104,
+   97, 89, 85, 87, 97,115,137,155,168,171,168,161,153,148,145,143,
+  139,133,126,120,115,112,110,106, 99, 92, 86, 86, 94,110,131,151,
+  165,171,169,162,155,149,146,143,140,135,128,121,116,113,110,107,
+  101, 94, 87, 85, 91,105,125,145,161,170,170,164,157,150,146,144,
+  141,136,130,123,117,114,111,108,103, 96, 89, 86, 89,101,120,140,
+  158,168,170,166,158,151,147,144,142,138,132,125,119,115,112,109,
+  105, 99, 91, 86, 88, 97,114,135,153,166,170,167,160,153,148,145,
+  142,139,133,127,120,116,113,110,107,101, 93, 88, 87, 94,109,129,
+  148,163,169,168,162,154,149,145,143,140,135,129,122,117,114,111,
+  108,103, 96, 89, 87, 92,105,124,143,159,168,168,163,156,150,146,
+  143,141,136,130,124,118,114,112,109,105, 98, 91, 87, 90,101,118,
+  138,155,166,169,165,158,151,146,144,141,138,132,126,120,115,113,
+  110,106,100, 93, 88, 89, 97,113,133,151,164,168,166,159,152,147,
+  144,142,139,134,127,121,116,114,111,108,102, 95, 89, 88, 95,109,
+  127,146,161,167,167,161,154,148,145,143,140,135,129,123,118,114,
+  112,109,104, 97, 91, 88, 92,104,122,141,157,166,167,163,156,149,
+  145,143,140,137,131,124,119,115,113,110,106,100, 93, 89, 91,101,
+  117,136,153,164,167,164,157,151,146,143,141,138,132,126,120,116,
+  114,111,108,102, 95, 90, 90, 98,112,131,149,162,167,165,159,152,
+  147,144,142,139,134,128,122,117,114,112,109,104, 97, 91, 90, 95,
+  108,126,144,159,166,166,160,154,148,144,142,140,135,130,123,118,
+  115,113,110,106, 99, 93, 90, 93,104,121,139,155,164,166,162,155,
+  149,145,143,140,137,131,125,120,116,114,111,107,101, 95, 90, 92,
+  101,116,135,151,162,166,163,157,150,146,143,141,138,133,127,121,
+  117,114,112,109,103, 97, 91, 91, 98,112,129,147,160,165,164,158,
+  152,147,143,141,139,134,128,122,118,115,113,110,105, 99, 93, 91,
+   96,107,125,142,157,164,165,160,153,148,144,142,139,135,130,124,
+  119,116,114,111,107,101, 94, 91, 94,104,120,138,153,163,165,161,
+  155,149,145,142,140,137,132,126,120,116,114,112,108,103, 96, 92,
+   93,101,115,133,149,160,164,162,156,150,145,143,141,138,133,127,
+  122,117,115,113,110,105, 98, 93, 92, 98,111,128,145,158,164,163,
+  158,151,146,143,141,139,134,129,123,118,116,114,111,106,100, 94,
+   92, 96,107,123,141,155,163,163,159,153,147,144,141,139,136,130,
+  125,120,116,114,112,108,102, 96, 92, 95,104,119,136,151,161,163,
+  160,154,148,144,142,140,137,132,126,121,117,115,113,109,104, 98,
+   93, 94,101,114,131,147,159,163,161,156,150,145,142,140,138,133,
+  128,122,118,115,114,111,106,100, 94, 93, 98,110,127,143,156,162,
+  162,157,151,146,143,141,138,135,129,124,119,116,114,112,108,102,
+   96, 93, 97,107,122,139,153,161,162,158,152,147,143,141,139,136,
+  131,125,120,117,115,113,109,104, 98, 94, 95,104,118,134,149,159,
+  162,160,154,148,144,142,140,137,132,127,121,118,115,114,110,105,
+   99, 95, 95,101,114,130,146,157,162,160,155,149,145,142,140,138,
+  133,128,123,119,116,114,112,107,101, 96, 94, 99,110,125,142,154,
+  161,161,157,151,146,142,140,138,135,130,124,120,117,115,113,109,
+  103, 97, 95, 97,107,121,137,151,159,161,158,152,147,143,141,139,
+  136,131,126,121,118,115,113,110,105, 99, 95, 96,104,117,133,148,
+  158,161,159,153,148,144,141,139,137,132,127,122,118,116,114,111,
+  107,101, 96, 96,101,113,128,144,155,160,160,155,149,144,142,140,
+  137,134,129,123,119,117,115,112,108,103, 97, 96, 99,109,124,140,
+  153,159,160,156,150,145,142,140,138,135,130,125,120,117,115,113,
+  110,104, 99, 96, 98,106,120,136,149,158,160,157,152,146,143,140,
+  139,136,131,126,121,118,116,114,111,106,101, 97, 97,104,116,131,
+  146,156,160,158,153,147,143,141,139,137,133,128,123,119,117,115,
+  112,108,102, 98, 97,102,112,127,142,154,159,159,154,149,144,141,
+  139,137,134,129,124,120,117,115,113,109,104, 99, 97,100,109,123,
+  138,151,158,159,155,150,145,142,140,138,135,130,125,121,118,116,
+  114,111,106,100, 97, 99,106,119,134,148,156,159,156,151,146,142,
+  140,138,136,132,127,122,119,117,115,112,107,102, 98, 98,104,115,
+  130,144,154,159,157,153,147,143,141,139,137,133,128,123,119,117,
+  115,113,109,104, 99, 98,102,112,126,141,152,158,158,154,148,144,
+  141,139,137,134,129,124,120,118,116,114,110,105,100, 98,100,109,
+  122,137,149,157,158,155,150,145,141,140,138,135,131,126,121,118,
+  117,115,112,107,102, 98, 99,106,118,133,146,155,158,156,151,146,
+  142,140,138,136,132,127,123,119,117,115,113,109,103, 99, 99,104,
+  115,129,143,153,157,156,152,147,143,140,139,136,133,128,124,120,
+  118,116,114,110,105,100, 99,102,112,125,139,150,157,157,153,148,
+  144,141,139,137,134,130,125,121,118,117,115,111,106,102, 99,101,
+  109,121,135,148,155,157,154,149,144,141,139,138,135,131,126,122,
+  119,117,115,113,108,103, 99,100,106,118,132,145,153,157,155,150,
+  145,142,140,138,136,132,127,123,120,118,116,114,110,105,100,100,
+  104,114,128,141,151,156,156,152,147,142,140,138,136,133,129,124,
+  121,118,117,115,111,106,102,100,103,111,124,138,149,155,156,153,
+  148,143,140,139,137,134,130,125,121,119,117,115,112,108,103,100,
+  102,109,120,134,146,154,156,154,149,144,141,139,137,135,131,127,
+  122,119,118,116,113,109,104,101,101,106,117,130,143,152,156,154,
+  150,145,141,139,138,136,132,128,124,120,118,117,114,111,106,102,
+  101,105,114,127,140,150,155,155,151,146,142,140,138,136,133,129,
+  125,121,119,117,115,112,107,103,101,103,111,123,136,147,154,155,
+  152,147,143,140,138,137,134,130,126,122,119,118,116,113,109,104,
+  101,102,109,120,133,145,153,155,153,149,144,141,139,137,135,131,
+  127,123,120,118,117,114,110,105,102,102,107,116,129,142,151,155,
+  154,150,145,141,139,138,136,132,128,124,121,119,117,115,112,107,
+  103,101,105,113,126,138,149,154,154,151,146,142,139,138,136,133,
+  129,125,122,119,118,116,113,108,104,102,104,111,122,135,146,153,
+  154,152,147,143,140,138,137,134,130,126,122,120,118,117,114,110,
+  105,102,103,109,119,132,143,151,154,152,148,144,140,138,137,135,
+  132,127,123,120,119,117,115,111,107,103,102,107,116,128,140,149,
+  154,153,149,145,141,139,137,135,133,129,124,121,119,118,116,112,
+  108,104,102,105,113,125,137,147,153,153,150,146,142,139,138,136,
+  133,130,126,122,120,118,116,114,109,105,103,104,111,121,134,145,
+  152,153,151,147,143,140,138,136,134,131,127,123,120,119,117,115,
+  111,106,103,104,109,118,130,142,150,153,152,148,143,140,138,137,
+  135,132,128,124,121,119,118,116,112,108,104,103,107,115,127,139,
+  148,153,152,149,144,141,139,137,135,133,129,125,122,120,118,116,
+  113,109,105,103,106,113,124,136,146,152,152,150,145,141,139,137,
+  136,133,130,126,122,120,119,117,114,110,106,104,105,111,121,133,
+  143,150,152,151,146,142,139,138,136,134,131,127,123,121,119,118,
+  115,112,107,104,104,109,118,129,141,149,152,151,147,143,140,138,
+  137,135,132,128,124,121,119,118,116,113,109,105,104,107,115,126,
+  138,147,151,152,148,144,141,138,137,135,133,129,125,122,120,119,
+  117,114,110,106,104,106,113,123,135,145,150,152,149,145,141,139,
+  137,136,133,130,126,123,120,119,118,115,111,107,105,105,111,120,
+  132,142,149,152,150,146,142,139,137,136,134,131,127,124,121,119,
+  118,116,113,109,105,105,109,117,128,139,148,151,150,147,143,140,
+  138,136,135,132,128,125,122,120,119,117,114,110,106,105,108,115,
+  125,137,146,150,151,148,144,140,138,137,135,133,129,126,122,120,
+  119,118,115,111,107,105,107,113,122,134,143,149,151,149,145,141,
+  138,137,136,133,130,127,123,121,119,118,116,112,108,106,106,111,
+  120,131,141,148,151,149,146,142,139,137,136,134,131,128,124,121,
+  120,119,117,114,110,106,106,109,117,128,138,146,150,150,147,143,
+  139,137,136,135,132,129,125,122,120,119,117,115,111,107,106,108,
+  115,125,135,144,149,150,148,144,140,138,136,135,133,130,126,123,
+  121,119,118,116,112,108,106,107,113,122,133,142,148,150,148,145,
+  141,138,137,135,133,131,127,124,121,120,119,117,113,109,106,107,
+  111,119,130,140,147,150,149,145,142,139,137,136,134,131,128,125,
+  122,120,119,117,114,111,107,106,109,117,127,137,145,149,149,146,
+  142,139,137,136,135,132,129,125,123,121,119,118,115,112,108,106,
+  108,114,124,134,143,148,149,147,143,140,138,136,135,133,130,126,
+  123,121,120,119,116,113,109,107,108,113,121,132,141,147,149,148,
+  144,141,138,136,135,133,131,127,124,122,120,119,117,114,110,107,
+  107,111,119,129,139,146,149,148,145,141,138,137,136,134,132,128,
+  125,122,121,119,118,115,111,108,107,110,116,126,136,144,148,149,
+  146,142,139,137,136,134,132,129,126,123,121,120,118,116,113,109,
+  107,109,114,123,133,142,147,149,147,143,140,137,136,135,133,130,
+  127,124,122,120,119,117,114,110,108,108,113,121,131,140,146,149,
+  147,144,140,138,136,135,133,131,128,124,122,121,119,118,115,111,
+  108,108,111,118,128,138,145,148,148,145,141,138,137,135,134,132,
+  128,125,123,121,120,118,116,112,109,108,110,116,125,135,143,147,
+  148,146,142,139,137,136,134,132,129,126,123,121,120,119,118,111,
+  119,131,130,134,137,139,140,139,139,138,138,137,137,136,133,129,
+  125,120,116,113,110,107,102, 95, 86, 77, 70, 69, 76, 91,113,139,
+  165,187,201,206,203,194,184,175,168,164,160,155,148,138,126,115,
+  106,100, 95, 91, 86, 77, 66, 53, 43, 40, 46, 63, 90,123,157,186,
+  206,215,214,206,194,182,172,166,162,158,152,144,133,122,111,103,
+   98, 94, 90, 83, 73, 61, 49, 42, 42, 52, 73,103,137,169,195,211,
+  215,211,200,188,177,169,164,160,155,149,139,128,117,108,101, 96,
+   93, 88, 80, 69, 57, 46, 41, 45, 61, 86,117,151,181,202,213,214,
+  206,194,182,173,166,162,158,153,145,135,124,113,105, 99, 95, 91,
+   85, 76, 64, 53, 44, 43, 51, 71, 99,132,164,190,207,214,210,201,
+  189,177,169,164,160,156,149,141,130,119,109,102, 98, 94, 89, 82,
+   72, 60, 49, 43, 46, 59, 82,113,146,176,198,211,212,206,195,183,
+  173,166,162,158,153,146,136,125,115,106,100, 96, 93, 87, 79, 68,
+   56, 47, 44, 51, 68, 95,126,159,186,204,212,210,201,189,178,169,
+  164,160,156,150,142,132,121,111,104, 99, 95, 91, 84, 75, 63, 52,
+   45, 46, 57, 79,108,140,171,194,208,211,206,196,184,174,166,162,
+  158,153,147,138,127,117,108,102, 98, 94, 89, 81, 70, 59, 49, 45,
+   50, 66, 91,121,153,181,200,210,209,201,190,179,170,164,160,156,
+  151,143,133,123,113,105,100, 96, 92, 86, 77, 66, 55, 47, 47, 56,
+   76,103,135,165,190,205,210,206,196,185,174,166,162,158,154,148,
+  139,129,118,109,103, 99, 95, 91, 83, 73, 62, 52, 47, 50, 64, 87,
+  117,148,176,197,207,208,201,191,179,170,164,160,156,151,144,135,
+  124,114,107,101, 97, 94, 88, 80, 69, 58, 50, 48, 56, 73, 99,130,
+  160,185,202,208,205,197,185,175,167,162,158,154,148,140,130,120,
+  111,104,100, 96, 92, 85, 76, 65, 55, 49, 51, 62, 84,112,143,171,
+  193,205,207,201,191,180,171,164,160,156,152,145,136,126,116,108,
+  102, 99, 95, 90, 82, 72, 61, 52, 49, 55, 71, 95,125,155,181,199,
+  206,205,197,186,175,167,162,158,154,149,141,132,122,113,106,101,
+   97, 94, 87, 79, 68, 57, 51, 51, 61, 81,108,138,167,189,202,206,
+  201,192,181,171,164,160,156,152,146,137,128,118,110,104,100, 96,
+   92, 85, 75, 64, 55, 51, 55, 69, 92,120,150,177,195,204,204,197,
+  187,176,167,162,158,154,150,142,133,123,114,107,102, 99, 95, 89,
+   81, 71, 60, 53, 52, 60, 78,104,133,162,185,199,204,201,192,181,
+  172,164,160,156,152,147,139,129,119,111,105,101, 97, 93, 87, 77,
+   67, 57, 52, 55, 67, 89,116,145,172,192,202,203,197,187,177,168,
+  162,158,154,150,143,135,125,116,108,103,100, 96, 91, 83, 73, 63,
+   55, 53, 60, 76,100,128,157,181,196,203,201,193,182,172,164,160,
+  156,153,147,140,131,121,112,106,102, 99, 95, 89, 80, 69, 60, 54,
+   55, 66, 86,112,141,167,188,200,202,197,188,177,168,162,158,154,
+  150,144,136,127,117,110,104,101, 97, 93, 86, 76, 66, 57, 54, 59,
+   74, 96,124,152,177,193,201,200,193,183,173,165,160,156,153,148,
+  141,132,123,114,107,103,100, 96, 90, 82, 72, 62, 56, 56, 65, 83,
+  108,136,163,184,197,201,197,188,178,169,162,158,154,151,145,137,
+  128,119,111,105,102, 98, 94, 88, 79, 68, 60, 56, 59, 72, 93,120,
+  148,172,190,199,199,193,183,173,165,160,156,153,148,142,133,124,
+  115,109,104,101, 97, 92, 85, 75, 65, 58, 57, 64, 80,104,132,158,
+  180,194,199,197,188,178,169,162,158,154,151,146,138,130,120,112,
+  107,103,100, 96, 90, 81, 71, 62, 57, 59, 71, 90,116,143,168,187,
+  197,198,193,184,174,165,160,156,153,149,143,135,126,117,110,105,
+  102, 98, 94, 87, 77, 68, 60, 58, 64, 78,100,127,154,176,192,198,
+  196,189,179,170,162,158,154,151,146,139,131,122,114,108,104,101,
+   97, 91, 83, 74, 65, 59, 60, 69, 87,112,139,164,183,195,197,193,
+  184,174,166,160,156,153,149,144,136,127,118,111,106,103, 99, 95,
+   89, 80, 70, 62, 59, 63, 76, 97,123,150,173,189,196,196,189,180,
+  170,163,158,154,151,147,140,132,123,115,109,105,102, 98, 93, 86,
+   76, 67, 61, 61, 68, 85,108,134,160,180,192,196,193,185,175,166,
+  160,156,153,149,144,137,128,120,112,107,103,101, 97, 91, 82, 73,
+   64, 60, 63, 75, 94,119,145,169,186,194,195,189,180,171,163,158,
+  154,151,147,141,133,125,117,110,106,102, 99, 95, 88, 79, 69, 63,
+   61, 68, 83,104,130,155,176,190,195,192,185,176,167,160,156,153,
+  150,145,138,130,121,114,108,104,102, 98, 92, 85, 75, 67, 62, 64,
+   74, 91,115,141,165,182,192,194,189,181,171,163,158,154,151,148,
+  142,135,126,118,111,107,103,100, 96, 90, 81, 72, 65, 62, 67, 81,
+  101,126,151,172,187,193,192,185,176,167,160,156,153,150,145,139,
+  131,123,115,109,105,102, 99, 94, 87, 78, 69, 64, 64, 73, 89,112,
+  137,161,179,190,193,189,181,172,164,158,154,151,148,143,136,128,
+  119,113,108,104,101, 98, 92, 83, 74, 67, 63, 67, 79, 98,122,147,
+  169,184,192,191,185,177,168,161,156,153,150,146,140,132,124,116,
+  110,106,103,100, 96, 89, 80, 71, 65, 65, 72, 87,108,133,156,176,
+  188,192,189,181,172,164,158,154,151,148,143,137,129,121,114,109,
+  105,102, 99, 93, 86, 77, 69, 65, 67, 78, 95,118,143,165,181,190,
+  191,186,177,168,161,156,153,150,146,141,134,125,118,111,107,104,
+  101, 97, 91, 82, 74, 67, 66, 71, 85,105,129,153,172,185,190,188,
+  182,173,165,158,154,151,148,144,138,130,122,115,110,106,103,100,
+   95, 88, 79, 71, 66, 68, 76, 93,115,139,161,178,188,190,185,178,
+  169,161,156,153,150,147,141,135,127,119,113,108,105,102, 99, 93,
+   85, 76, 69, 67, 71, 83,102,125,149,169,183,189,188,182,173,165,
+  159,154,151,149,145,139,131,123,116,111,107,104,101, 97, 90, 81,
+   73, 68, 68, 76, 91,111,135,157,175,186,189,185,178,169,162,156,
+  153,150,147,142,136,128,120,114,109,106,103,100, 94, 87, 78, 71,
+   68, 71, 82, 99,121,145,165,180,187,187,182,174,166,159,154,151,
+  149,145,139,132,125,117,112,108,105,102, 98, 92, 84, 75, 69, 69,
+   75, 89,108,131,154,172,183,188,185,178,170,162,156,153,150,147,
+  143,137,129,122,115,110,107,104,101, 96, 89, 80, 73, 69, 71, 80,
+   97,118,141,162,177,186,187,182,174,166,159,154,151,149,145,140,
+  133,126,119,113,109,106,103, 99, 93, 86, 77, 71, 70, 74, 87,105,
+  128,150,169,181,186,185,179,170,163,157,153,150,147,143,137,130,
+  123,116,111,108,105,102, 97, 91, 83, 75, 70, 71, 79, 94,115,137,
+  158,174,184,186,182,175,167,159,154,151,149,146,141,135,127,120,
+  114,110,107,104,101, 95, 88, 80, 73, 70, 74, 85,103,124,146,165,
+  179,185,184,179,171,163,157,153,150,147,144,138,131,124,117,112,
+  108,106,103, 99, 93, 85, 77, 72, 72, 78, 92,112,134,155,171,182,
+  185,182,175,167,160,155,151,149,146,141,135,128,121,115,110,108,
+  105,102, 97, 90, 82, 75, 72, 74, 84,100,121,143,162,176,183,184,
+  179,171,163,157,153,150,147,144,139,132,125,118,113,109,107,104,
+  100, 94, 87, 79, 73, 72, 78, 90,109,130,151,168,180,184,182,175,
+  168,160,155,151,149,146,142,136,129,122,116,111,108,106,103, 98,
+   92, 84, 77, 73, 74, 83, 98,118,139,159,174,182,183,179,172,164,
+  157,153,150,147,144,140,133,126,120,114,110,107,105,101, 96, 89,
+   81, 75, 73, 78, 89,106,127,148,165,177,182,181,176,168,161,155,
+  151,149,146,142,137,130,123,117,112,109,107,104,100, 93, 86, 79,
+   74, 75, 82, 96,115,136,155,171,180,182,179,172,164,158,153,150,
+  148,145,140,134,127,121,115,111,108,106,103, 98, 91, 83, 77, 74,
+   77, 87,103,123,144,162,175,181,181,176,168,161,155,151,149,146,
+  143,138,132,125,118,113,110,107,105,101, 95, 88, 81, 76, 75, 81,
+   94,112,132,152,168,178,181,179,172,165,158,153,150,148,145,141,
+  135,129,122,116,112,109,107,104, 99, 93, 85, 79, 75, 77, 86,101,
+  120,141,159,173,180,180,176,169,162,155,151,149,146,143,139,132,
+  126,119,114,111,108,106,102, 97, 90, 83, 77, 76, 81, 92,109,129,
+  149,165,176,180,178,173,165,158,153,150,147,145,141,136,130,123,
+  117,113,110,107,105,100, 94, 87, 80, 76, 78, 85, 99,117,137,156,
+  170,178,179,176,169,162,156,151,149,146,143,139,133,127,120,115,
+  111,109,107,103, 98, 92, 84, 79, 77, 81, 91,107,126,145,162,174,
+  179,178,173,166,159,153,150,147,145,142,137,131,124,118,114,110,
+  108,106,102, 96, 89, 82, 78, 78, 84, 97,115,134,153,167,176,179,
+  176,170,162,156,151,149,146,144,140,134,128,121,116,112,110,107,
+  104,100, 93, 86, 80, 78, 80, 89,104,123,142,159,172,178,177,173,
+  166,159,154,150,147,145,142,137,132,125,119,114,111,109,106,103,
+   98, 91, 84, 79, 79, 84, 95,112,131,150,165,174,178,176,170,163,
+  156,152,149,146,144,140,135,129,123,117,113,110,108,105,101, 95,
+   88, 82, 79, 80, 88,102,120,139,156,169,176,177,173,167,160,154,
+  150,147,145,142,138,132,126,120,115,112,110,107,104, 99, 93, 86,
+   81, 79, 83, 94,109,128,147,162,172,177,175,170,163,157,152,149,
+  146,144,141,136,130,124,118,114,111,109,106,102, 97, 90, 84, 80,
+   81, 88,100,117,136,153,167,175,176,173,167,160,154,150,147,145,
+  143,139,133,127,121,116,113,110,108,105,101, 94, 88, 82, 80, 83,
+   93,107,125,144,159,170,175,175,170,164,157,152,149,146,144,141,
+  136,131,125,119,115,112,110,107,104, 98, 92, 85, 81, 81, 87, 98,
+  115,133,150,164,173,175,173,167,160,154,150,147,145,143,139,134,
+  128,122,117,113,111,109,106,102, 96, 89, 84, 81, 83, 91,105,122,
+  140,157,168,174,174,170,164,158,152,149,146,144,141,137,132,126,
+  120,115,112,110,108,105,100, 94, 87, 82, 82, 86, 97,112,130,148,
+  162,171,174,173,167,161,155,150,147,145,143,140,135,129,123,118,
+  114,112,110,107,103, 98, 91, 85, 82, 83, 90,103,120,138,154,166,
+  173,174,170,164,158,152,149,146,144,142,138,132,127,121,116,113,
+  111,109,106,101, 95, 89, 84, 82, 86, 95,110,127,145,159,169,173,
+  172,168,161,155,150,147,145,143,140,136,130,124,119,115,112,110,
+  108,104, 99, 93, 87, 83, 84, 90,101,117,135,151,164,171,173,170,
+  165,158,153,149,146,144,142,138,133,127,122,117,114,111,109,107,
+  103, 97, 90, 85, 83, 86, 94,108,124,142,157,167,172,172,168,162,
+  156,151,147,145,143,140,136,131,125,120,116,113,111,109,105,101,
+   94, 88, 84, 84, 89,100,115,132,148,162,170,172,170,165,159,153,
+  149,146,144,142,139,134,128,123,118,114,112,110,108,104, 98, 92,
+   87, 84, 86, 93,106,122,139,154,165,171,171,168,162,156,151,147,
+  145,143,141,137,132,126,121,116,113,111,109,106,102, 96, 90, 86,
+   85, 89, 98,112,129,146,159,168,171,170,165,159,153,149,146,144,
+  142,139,135,129,124,119,115,113,111,109,105,100, 94, 88, 85, 86,
+   92,104,119,136,152,163,170,171,168,162,156,151,147,145,143,141,
+  137,132,127,122,117,114,112,110,107,103, 98, 92, 87, 85, 88, 97,
+  110,126,143,157,166,170,170,165,159,154,149,146,144,142,139,135,
+  130,125,120,116,113,111,109,106,101, 95, 90, 86, 86, 92,102,117,
+  133,149,161,168,170,168,163,157,151,148,145,143,141,138,133,128,
+  122,118,115,113,111,108,104, 99, 93, 88, 86, 88, 96,108,124,140,
+  154,164,169,169,165,160,154,149,146,144,142,140,136,131,126,121,
+  117,114,112,110,107,103, 97, 91, 87, 87, 91,101,115,131,146,159,
+  167,169,168,163,157,152,148,145,143,141,138,134,129,123,119,115,
+  113,111,109,106,101, 95, 90, 87, 88, 95,107,122,137,152,163,168,
+  169,165,160,154,150,146,144,142,140,136,132,126,121,117,115,113,
+  111,108,104, 98, 93, 88, 87, 91,100,113,128,144,157,165,169,167,
+  163,157,152,148,145,143,141,138,134,129,124,120,116,114,112,110,
+  107,102, 96, 91, 88, 89, 94,105,119,135,149,161,167,168,165,160,
+  155,150,146,144,142,140,137,132,127,122,118,115,113,111,109,105,
+  100, 94, 90, 88, 91, 99,111,126,141,154,163,168,167,163,158,152,
+  148,145,143,141,139,135,130,125,120,117,114,113,111,108,103, 98,
+   92, 89, 89, 94,104,117,132,147,158,165,168,165,161,155,150,146,
+  144,142,140,137,133,128,123,119,116,114,112,110,106,101, 96, 91,
+   89, 91, 98,109,123,139,152,162,167,167,163,158,153,148,145,143,
+  141,139,136,131,126,121,117,115,113,111,109,104, 99, 94, 90, 89,
+   93,102,115,130,144,156,164,167,165,161,155,150,147,144,142,140,
+  138,134,129,124,120,116,114,113,110,107,103, 97, 92, 90, 91, 97,
+  107,121,136,150,160,165,166,163,158,153,148,145,143,141,139,136,
+  132,127,122,118,115,114,112,109,106,101, 95, 91, 90, 93,101,113,
+  128,142,154,162,166,165,161,156,151,147,144,142,141,138,134,130,
+  125,120,117,115,113,111,108,104, 99, 94, 91, 91, 96,106,119,134,
+  147,158,164,166,163,159,153,149,145,143,142,139,136,132,128,123,
+  119,116,114,113,110,107,102, 97, 92, 91, 93,100,111,125,140,152,
+  161,165,165,161,156,151,147,144,142,141,138,135,130,125,121,118,
+  115,114,112,109,105,100, 95, 91, 91, 96,105,117,131,145,156,163,
+  165,163,159,153,149,145,143,142,140,137,133,128,124,120,117,115,
+  113,111,108,103, 98, 93, 91, 93, 99,110,123,137,150,159,164,164,
+  161,156,151,147,144,142,141,138,135,131,126,122,118,116,114,112,
+  110,106,101, 96, 93, 92, 95,103,115,129,143,154,161,164,163,159,
+  154,149,145,143,142,140,137,133,129,124,120,117,115,114,112,109,
+  104, 99, 95, 92, 93, 98,108,121,135,148,157,163,164,161,157,151,
+  147,144,142,141,139,136,132,127,123,119,116,115,113,111,107,103,
+   98, 94, 92, 95,102,113,127,141,152,160,163,163,159,154,149,146,
+  143,141,140,137,134,130,125,121,118,116,114,112,110,106,101, 96,
+   93, 93, 98,107,119,133,146,156,162,163,161,157,152,147,144,142,
+  141,139,136,132,128,123,120,117,115,114,112,108,104, 99, 95, 93,
+   95,101,112,125,138,150,158,162,162,159,154,150,146,143,141,140,
+  138,134,130,126,122,118,116,115,113,110,107,102, 97, 94, 94, 97,
+  106,117,131,143,154,160,163,161,157,152,148,144,142,141,139,136,
+  133,128,124,120,117,116,114,112,109,105,100, 96, 94, 95,101,110,
+  123,136,148,157,162,162,159,155,150,146,143,141,140,138,135,131,
+  127,122,119,117,115,114,111,108,103, 98, 95, 94, 97,105,115,128,
+  141,152,159,162,161,157,152,148,144,142,141,139,137,133,129,125,
+  121,118,116,115,113,110,106,101, 97, 95, 95,100,109,121,134,146,
+  155,160,161,159,155,150,146,143,141,140,138,135,132,127,123,120,
+  117,116,114,112,109,104,100, 96, 95, 97,104,114,126,139,150,158,
+  161,161,157,153,148,145,142,141,139,137,134,130,125,122,119,117,
+  115,113,111,107,103, 98, 95, 95,100,108,119,132,144,154,159,161,
+  159,155,150,146,143,141,140,138,136,132,128,124,120,118,116,115,
+  113,110,106,101, 97, 95, 97,103,112,124,137,148,156,160,160,157,
+  153,148,145,142,141,139,137,134,130,126,122,119,117,116,114,112,
+  108,104, 99, 96, 96, 99,107,117,130,142,152,158,160,159,155,151,
+  147,143,141,140,138,136,133,129,124,121,118,116,115,113,111,107,
+  102, 98, 96, 97,102,111,123,135,146,155,159,160,157,153,149,145,
+  142,141,139,137,135,131,127,123,120,118,116,115,112,109,105,101,
+   97, 96, 99,106,116,128,140,150,157,160,159,155,151,147,144,141,
+  140,138,136,133,129,125,122,119,117,116,114,111,108,103, 99, 97,
+   97,102,110,121,133,144,153,158,159,157,153,149,145,142,141,139,
+  138,135,132,128,124,120,118,116,115,113,110,106,102, 98, 97, 99,
+  105,114,126,138,148,156,159,159,156,151,147,144,141,140,139,136,
+  134,130,126,122,119,117,116,114,112,109,105,100, 98, 97,101,109,
+  119,131,142,152,157,159,157,154,149,145,142,141,139,138,135,132,
+  128,124,121,119,117,116,114,111,107,103, 99, 97, 99,104,113,124,
+  136,146,154,158,158,156,151,147,144,141,140,139,137,134,130,126,
+  123,120,118,116,115,113,110,106,101, 98, 98,101,108,118,129,141,
+  150,156,158,157,154,149,145,143,141,139,138,136,133,129,125,122,
+  119,117,116,114,112,108,104,100, 98, 99,103,112,122,134,145,153,
+  157,158,156,152,148,144,141,140,139,137,134,131,127,123,120,118,
+  117,116,114,111,107,103, 99, 98,101,107,116,127,139,148,155,158,
+  157,154,150,146,143,141,139,138,136,133,129,126,122,119,118,116,
+  115,113,109,105,101, 99, 99,103,110,121,132,143,151,156,157,156,
+  152,148,144,142,140,139,137,135,131,128,124,121,119,117,116,114,
+  111,108,104,100, 99,101,106,115,126,137,147,153,157,157,154,150,
+  146,143,141,139,138,136,133,130,126,123,120,118,117,115,113,110,
+  106,102,100, 99,103,109,119,130,141,150,155,157,155,152,148,144,
+  142,140,139,137,135,132,128,125,122,119,118,116,115,112,109,105,
+  101, 99,101,105,113,124,135,145,152,156,156,154,150,146,143,141,
+  139,138,136,134,130,127,123,120,119,117,116,114,111,107,103,100,
+  100,102,109,118,129,139,148,154,156,155,152,148,145,142,140,139,
+  137,135,132,129,125,122,120,118,117,115,113,110,106,102,100,101,
+  105,112,122,133,143,151,155,156,154,150,146,143,141,139,138,136,
+  134,131,127,124,121,119,118,116,115,112,108,104,101,100,102,108,
+  116,127,137,147,153,156,155,152,148,145,142,140,139,137,135,133,
+  129,126,123,120,118,117,116,114,111,107,103,101,101,104,111,121,
+  131,141,149,154,155,154,151,147,143,141,139,138,137,134,131,128,
+  124,122,119,118,117,115,113,109,105,102,101,102,107,115,125,136,
+  145,152,155,155,152,149,145,142,140,139,137,136,133,130,126,123,
+  121,119,118,116,114,112,108,104,101,101,104,110,119,130,140,148,
+  153,155,154,151,147,143,141,139,138,137,135,132,128,125,122,120,
+  118,117,116,113,110,106,103,101,102,107,114,124,134,143,150,154,
+  155,152,149,145,142,140,139,137,136,133,130,127,124,121,119,118,
+  117,115,112,109,105,102,102,104,109,118,128,138,147,152,154,154,
+  151,147,144,141,139,138,137,135,132,129,126,123,120,119,118,116,
+  114,111,107,104,102,102,106,113,122,132,142,149,153,154,152,149,
+  145,142,140,139,137,136,134,131,128,124,122,120,118,117,116,113,
+  110,106,103,102,104,109,117,126,136,145,151,154,153,151,147,144,
+  141,139,138,137,135,133,129,126,123,121,119,118,117,115,112,108,
+  105,103,103,106,112,121,131,140,148,152,154,152,149,146,142,140,
+  138,137,136,134,131,128,125,122,120,119,118,116,114,111,107,104,
+  102,104,108,116,125,135,144,150,153,153,151,148,144,141,139,138,
+  137,135,133,130,127,124,121,120,118,117,115,113,109,106,103,103,
+  105,111,119,129,139,146,151,153,152,149,146,143,140,138,137,136,
+  134,132,129,125,123,120,119,118,117,115,111,108,105,103,104,108,
+  114,123,133,142,149,152,153,151,148,144,141,139,138,137,135,133,
+  130,127,124,122,120,119,118,116,113,110,107,104,103,105,110,118,
+  128,137,145,150,153,152,150,146,143,140,138,137,136,135,132,129,
+  126,123,121,119,118,117,115,112,109,106,104,104,107,114,122,132,
+  141,147,151,152,151,148,144,141,139,138,137,135,134,131,128,125,
+  122,120,119,118,116,114,111,108,105,104,105,110,117,126,135,144,
+  149,152,152,150,146,143,140,138,137,136,135,132,130,126,124,121,
+  120,119,118,116,113,110,107,104,104,107,113,121,130,139,146,151,
+  152,151,148,145,142,139,138,137,136,134,131,128,125,123,121,119,
+  118,117,115,112,109,106,104,105,109,116,125,134,142,148,151,152,
+  150,146,143,140,139,137,136,135,133,130,127,124,122,120,119,118,
+  116,114,111,107,105,104,107,112,120,129,138,145,150,152,151,148,
+  145,142,139,138,137,136,134,132,129,126,123,121,120,119,117,115,
+  113,109,106,105,105,109,115,123,132,141,147,151,151,150,147,143,
+  141,139,137,136,135,133,130,127,125,122,120,119,118,117,115,112,
+  108,106,105,107,111,118,127,136,144,149,151,151,148,145,142,139,
+  138,137,136,134,132,129,126,123,121,120,119,118,116,113,110,107,
+  105,105,108,114,122,131,139,146,150,151,150,147,144,141,139,137,
+  136,135,133,131,128,125,123,121,120,119,117,115,112,109,106,105,
+  107,111,117,126,135,142,148,150,150,148,145,142,140,138,137,136,
+  134,132,130,127,124,122,120,119,118,117,114,111,108,106,106,108,
+  113,121,130,138,145,149,150,149,147,144,141,139,137,136,135,133,
+  131,128,125,123,121,120,119,118,116,113,110,107,106,107,110,116,
+  124,133,141,147,150,150,148,145,142,140,138,137,136,134,133,130,
+  127,124,122,121,120,119,117,115,112,109,107,106,108,113,120,128,
+  137,144,148,150,149,147,144,141,139,137,136,135,134,131,129,126,
+  123,122,120,119,118,116,114,111,108,106,107,110,116,123,132,140,
+  146,149,150,148,146,142,140,138,137,136,135,133,130,128,125,123,
+  121,120,119,118,116,113,110,107,106,108,112,119,127,135,142,147,
+  149,149,147,144,141,139,137,136,135,134,132,129,126,124,122,121,
+  120,119,117,115,112,109,107,107,109,115,122,130,138,145,148,149,
+  148,146,143,140,138,137,136,135,133,131,128,125,123,121,120,119,
+  118,116,113,110,108,107,108,112,118,126,134,141,146,149,149,147,
+  144,141,139,137,136,135,134,132,130,127,124,122,121,120,119,117,
+  115,112,109,107,107,109,114,121,129,137,143,148,149,148,146,143,
+  140,138,137,136,135,133,131,128,126,123,122,121,120,118,117,114,
+  111,109,107,108,111,117,124,132,140,145,148,149,147,144,141,139,
+  137,136,135,134,132,130,127,125,123,121,120,119,118,116,113,110,
+  108,107,109,113,120,128,136,142,147,149,148,146,143,140,138,137,
+  136,135,133,131,129,126,124,122,121,120,119,117,115,112,109,108,
+  108,111,116,123,131,139,144,148,148,147,145,142,139,137,136,135,
+  134,133,130,128,125,123,122,121,120,118,116,114,111,109,108,109,
+  113,119,127,134,141,146,148,148,146,143,140,138,137,136,135,134,
+  132,129,127,124,122,121,120,119,118,116,113,110,108,108,110,115,
+  122,130,137,143,147,148,147,145,142,139,137,136,135,134,133,131,
+  128,126,123,122,121,120,119,117,115,112,109,108,109,112,118,125,
+  133,140,145,147,148,146,143,141,138,137,136,135,134,132,130,127,
+  125,123,121,120,120,118,116,113,111,109,108,110,115,121,129,136,
+  142,146,148,147,145,142,139,137,136,135,134,133,131,129,126,124,
+  122,121,120,119,118,115,112,110,109,109,112,117,124,132,139,144,
+  147,147,146,143,141,138,137,136,135,134,132,130,127,125,123,122,
+  121,120,119,117,114,111,109,109,110,114,120,127,135,141,145,147,
+  147,145,142,140,138,136,135,134,133,131,129,126,124,122,121,120,
+  120,118,116,113,111,109,109,112,117,123,131,138,143,146,147,146,
+  144,141,139,137,136,135,134,132,130,128,125,123,122,121,120,119,
+  117,115,112,110,109,110,114,119,126,134,140,145,147,147,145,142,
+  140,138,136,135,134,133,132,129,127,125,123,122,121,120,118,116,
+  114,111,110,109,111,116,122,129,136,142,146,147,146,144,141,139,
+  137,136,135,134,133,131,128,126,124,122,121,120,119,118,116,113,
+  111,109,110,113,118,125,132,139,144,146,146,145,142,140,138,136,
+  135,134,133,132,130,127,125,123,122,121,120,119,117,115,112,110,
+  110,111,115,121,128,135,141,145,146,146,144,141,139,137,136,135,
+  134,133,131,129,126,124,123,122,121,120,118,116,114,111,110,110,
+  113,118,124,131,138,143,146,146,145,143,140,138,136,135,134,133,
+  132,130,128,125,123,122,121,120,119,118,115,113,111,110,111,115,
+  120,127,134,140,144,146,146,144,141,139,137,136,135,134,133,131,
+  129,127,125,123,122,121,120,119,117,114,112,110,110,113,117,123,
+  130,137,142,145,146,145,143,140,138,136,135,134,134,132,130,128,
+  126,124,122,122,121,120,118,116,113,111,110,111,114,120,126,133,
+  139,143,145,145,144,142,139,137,136,135,134,133,131,129,127,125,
+  123,122,121,120,119,117,115,112,111,111,112,116,122,129,136,141,
+  144,146,145,143,140,138,136,135,134,134,132,131,128,126,124,123,
+  122,121,120,119,116,114,112,111,111,114,119,125,132,138,142,145,
+  145,144,142,139,137,136,135,134,133,132,130,127,125,124,122,122,
+  121,120,118,116,113,111,111,112,116,121,128,134,140,144,145,145,
+  143,140,138,136,135,134,134,132,131,129,126,124,123,122,121,120,
+  119,117,115,112,111,111,114,118,124,131,137,142,144,145,144,142,
+  139,137,136,135,134,133,132,130,128,126,124,123,122,121,120,118,
+  116,114,112,111,112,115,121,127,133,139,143,145,145,143,141,138,
+  136,135,134,134,133,131,129,127,125,123,122,121,121,119,118,115,
+  113,111,111,113,117,123,130,136,141,144,145,144,142,139,137,136,
+  135,134,133,132,130,128,126,124,123,122,121,120,119,117,114,112,
+  111,112,115,120,126,132,138,142,144,144,143,141,138,137,135,134,
+  134,133,131,129,127,125,124,122,122,121,120,118,116,114,112,112,
+  113,117,122,129,135,140,143,144,144,142,140,137,136,135,134,133,
+  132,130,128,126,124,123,122,121,121,119,117,115,113,112,112,115,
+  119,125,131,137,141,144,144,143,141,139,137,135,134,134,133,131,
+  130,128,126,124,123,122,121,120,119,116,114,112,112,113,116,122,
+  128,134,139,143,144,144,142,140,138,136,135,134,133,132,131,129,
+  127,125,123,122,122,121,120,118,116,113,112,112,114,119,124,130,
+  136,141,143,144,143,141,139,137,135,134,134,133,132,130,128,126,
+  124,123,122,121,121,119,117,115,113,112,113,116,121,127,133,138,
+  142,144,144,142,140,138,136,135,134,133,132,131,129,127,125,124,
+  123,122,121,120,118,116,114,113,113,114,118,123,130,135,140,143
+};
+
+static const flashbank_entry_t flashbank_index[1] PROGMEM = {
+  { "chime", 9600 },
+};
+
+/*! \brief  Far flash address of a clip */
+static uint32_t flashbank_addr(uint8_t index)
+{
+  switch (index) {
+    case 0: return pgm_get_far_address(flashbank_clip0);
+  }
+
+  return 0;
+}
+
+#endif // FLASHBANK_DATA_H_
@@ -0,0 +1,106 @@
+/*!
+ *  \file    gain.c
+ *  \brief   Fixed-point gain stage with linear ramps
+ *
+ *  \details The scaled samples are int16_t sums around GAIN_MID that may
+ *           leave the DAC range when the gain is above unity; the caller
+ *           limits them (see mixer.c).
+ */
+#include "gain.h"
+
+#include <avr/pgmspace.h>
+
+/*! \brief  round(32768 * 10^(dB / 20)) for GAIN_DB_MAX down to GAIN_DB_MIN */
+static const uint16_t db_table[GAIN_DB_MAX - GAIN_DB_MIN + 1] PROGMEM = {
+  65381, 58271, 51934, 46286, 41252, 36766, 32768, 29205,
+  26029, 23198, 20675, 18427, 16423, 14637, 13045, 11627,
+  10362,  9235,  8231,  7336,  6538,  5827,  5193,  4629,
+   4125,  3677,  3277,  2920,  2603,  2320,  2068,  1843,
+   1642,  1464,  1305,  1163,  1036,   924,   823,   734,
+    654,   583,   519,   463,   413,   368,   328,   292,
+    260,   232,   207,   184,   164,   146,   130,   116,
+    104,    92,    82,    73,    65,    58,    52,    46,
+     41,    37,    33
+};
+
+/*! \brief  Convert a level in dB to a gain
+ *
+ *  \param  db       level, 0 is unity; clamped to GAIN_DB_MAX
+ *
+ *  \return Q15 gain, 0 below GAIN_DB_MIN
+ */
+uint16_t gain_db(int8_t db)
+{
+  if (db > GAIN_DB_MAX) db = GAIN_DB_MAX;
+  if (db < GAIN_DB_MIN) return 0;
+
+  return pgm_read_word(&db_table[GAIN_DB_MAX - db]);
+}
+
+/*! \brief  Set a constant gain
+ *
+ *  \param  g        gain
+ *  \param  gain     Q15
+ *
+ *  \return void
+ */
+void gain_init(gain_ramp_t *g, uint16_t gain)
+{
+  g->cur    = (uint32_t) gain << 8;
+  g->step   = 0;
+  g->target = gain;
+  g->left   = 0;
+}
+
+/*! \brief  Start a linear ramp from the gain now to a new gain
+ *
+ *  \param  g        gain
+ *  \param  target   Q15 gain at the end of the ramp
+ *  \param  samples  length of the ramp, 0 to change at once
+ *
+ *  \return void
+ */
+void gain_set(gain_ramp_t *g, uint16_t target, uint16_t samples)
+{
+  if (samples == 0) {
+    gain_init(g, target);
+    return;
+  }
+  g->step   = ((int32_t) ((uint32_t) target << 8) - (int32_t) g->cur) / samples;
+  g->target = target;
+  g->left   = samples;
+}
+
+/*! \brief  Scale a block of 12-bit DAC codes in place
+ *
+ *  \param  g        gain, the ramp advances by n samples
+ *  \param  buf      block
+ *  \param  n        number of samples
+ *
+ *  \details Samples at unity gain after the ramp are not touched.
+ *
+ *  \return void
+ */
+void gain_apply(gain_ramp_t *g, uint16_t *buf, uint16_t n)
+{
+  uint16_t i = 0, m, gain;
+  uint32_t cur = g->cur;
+
+  if (g->left) {
+    m = n < g->left ? n : g->left;
+    for (; i < m; i++) {
+      buf[i] = GAIN_MID + (int16_t) (((int32_t) ((int16_t) buf[i] - GAIN_MID) * (uint16_t) (cur >> 8)) >> 15);
+      cur += g->step;
+    }
+    g->left -= m;
+    if (g->left == 0) cur = (uint32_t) g->target << 8;   // no rounding error left
+    g->cur = cur;
+  }
+
+  gain = cur >> 8;
+  if (gain != GAIN_UNITY) {
+    for (; i < n; i++) {
+      buf[i] = GAIN_MID + (int16_t) (((int32_t) ((int16_t) buf[i] - GAIN_MID) * gain) >> 15);
+    }
+  }
+}
@@ -0,0 +1,63 @@
+/*!
+ *  \file    gain.h
+ *  \brief   Fixed-point gain stage with linear ramps
+ *
+ *  \details A gain is a Q15 factor: GAIN_UNITY (0x8000) is 1.0, gains up
+ *           to 0xFFFF amplify. It scales the 12-bit DAC codes around
+ *           mid-scale. gain_db() converts a level in dB with a table in
+ *           flash, so no floating point is needed.
+ *
+ *           A change of gain is spread over a number of samples as a linear
+ *           ramp (gain_set()); without a ramp the output would jump and
+ *           click. gain_apply() scales a block in place: while the ramp runs
+ *           the gain changes every sample, after the ramp it is constant.
+ *
+ *           The gain is applied in the main loop when a block is made, so
+ *           it adds nothing to the output interrupt.
+ */
+#ifndef GAIN_H_
+#define GAIN_H_
+
+#include <stdint.h>
+
+#define GAIN_UNITY      0x8000  //!< gain 1.0 (Q15)
+#define GAIN_MID        2048    //!< DAC code of silence
+#define GAIN_DB_MAX     6       //!< highest level in the table, dB
+#define GAIN_DB_MIN     (-60)   //!< lowest level in the table, dB; lower is muted
+
+/*! \brief  Gain with a linear ramp */
+typedef struct {
+  uint32_t cur;                 //!< gain now, Q15 with 8 extra fraction bits
+  int32_t  step;                //!< change of cur per sample
+  uint16_t target;              //!< gain at the end of the ramp, Q15
+  uint16_t left;                //!< samples left in the ramp, 0: constant
+} gain_ramp_t;
+
+uint16_t gain_db(int8_t db);
+void     gain_init(gain_ramp_t *g, uint16_t gain);
+void     gain_set(gain_ramp_t *g, uint16_t target, uint16_t samples);
+void     gain_apply(gain_ramp_t *g, uint16_t *buf, uint16_t n);
+
+/*! \brief  Get the gain now
+ *
+ *  \param  g        gain
+ *
+ *  \return Q15 gain
+ */
+static inline uint16_t gain_now(const gain_ramp_t *g)
+{
+  return g->cur >> 8;
+}
+
+/*! \brief  Test if a ramp is running
+ *
+ *  \param  g        gain
+ *
+ *  \return 1 while the gain changes, 0 when it is constant
+ */
+static inline uint8_t gain_ramping(const gain_ramp_t *g)
+{
+  return g->left != 0;
+}
+
+#endif // GAIN_H_
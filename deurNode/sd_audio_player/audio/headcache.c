@@ -0,0 +1,109 @@
+/*!
+ *  \file    headcache.c
+ *  \brief   RAM cache with the first part of the hot clips
+ *
+ *  \details The pool is handed out from the start to the end; there is no
+ *           freeing of single clips, only headcache_clear().
+ */
+#include "headcache.h"
+
+#include <string.h>
+
+#if HEADCACHE_BYTES
+static uint16_t          pool[HEADCACHE_BYTES / sizeof(uint16_t)];
+#endif
+static headcache_entry_t entries[HEADCACHE_CLIPS];
+static uint8_t           n_entries;
+static uint16_t          pool_used;                 //!< samples handed out
+static headcache_stats_t stats;
+
+/*! \brief  Reserve memory for the start of a clip
+ *
+ *  \param  path     name of the file, must stay valid
+ *  \param  samples  number of samples wanted
+ *
+ *  \details The entry gets at most the free part of the pool. The caller
+ *           fills in the data and sets info, rate, samples and complete.
+ *
+ *  \return pointer to the entry with samples set to the memory given,
+ *          0 if the pool or the table is full
+ */
+headcache_entry_t *headcache_alloc(const char *path, uint16_t samples)
+{
+  headcache_entry_t *e;
+  uint16_t           left = HEADCACHE_BYTES / sizeof(uint16_t) - pool_used;
+
+  if (n_entries >= HEADCACHE_CLIPS || left == 0) return 0;
+
+  e = &entries[n_entries++];
+  if (samples > left) samples = left;
+  e->path     = path;
+#if HEADCACHE_BYTES
+  e->data     = pool + pool_used;
+#endif
+  e->samples  = samples;
+  e->complete = 0;
+  pool_used  += samples;
+  stats.used  = pool_used * sizeof(uint16_t);
+
+  return e;
+}
+
+/*! \brief  Look up a clip
+ *
+ *  \param  path     name of the file
+ *
+ *  \details Counts a hit or a miss.
+ *
+ *  \return pointer to the entry, 0 if the clip is not cached
+ */
+const headcache_entry_t *headcache_find(const char *path)
+{
+  uint8_t i;
+
+  for (i = 0; i < n_entries; i++) {
+    if (entries[i].samples && strcmp(entries[i].path, path) == 0) {
+      stats.hits++;
+      return &entries[i];
+    }
+  }
+  stats.misses++;
+
+  return 0;
+}
+
+/*! \brief  Count the end of the cached part of a clip
+ *
+ *  \param  late     1: the file was not open yet when the cached part ran out
+ *  \param  ok       1: the file continued, 0: it could not be opened
+ *
+ *  \return void
+ */
+void headcache_handover(uint8_t late, uint8_t ok)
+{
+  if (ok) stats.handovers++;
+  else    stats.failed++;
+  if (late) stats.late++;
+}
+
+/*! \brief  Remove all clips from the cache
+ *
+ *  \return void
+ */
+void headcache_clear(void)
+{
+  n_entries  = 0;
+  pool_used  = 0;
+  stats.used = 0;
+}
+
+/*! \brief  Get a copy of the cache statistics
+ *
+ *  \param  st       pointer to store the statistics
+ *
+ *  \return void
+ */
+void headcache_get_stats(headcache_stats_t *st)
+{
+  *st = stats;
+}
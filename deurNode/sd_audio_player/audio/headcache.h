@@ -0,0 +1,56 @@
+/*!
+ *  \file    headcache.h
+ *  \brief   RAM cache with the first part of the hot clips
+ *
+ *  \details At start-up the player decodes the first HEADCACHE_CLIP_MS
+ *           milliseconds of each hot clip into a pool of HEADCACHE_BYTES
+ *           bytes (player_cache()). A clip that is in the cache starts from
+ *           RAM without any SD-card access; the file is opened while the
+ *           cached part plays and continues at the exact next sample.
+ *
+ *           This file only manages the pool, the lookup and the statistics.
+ *           Set HEADCACHE_BYTES to 0 to leave the cache out.
+ */
+#ifndef HEADCACHE_H_
+#define HEADCACHE_H_
+
+#include <stdint.h>
+#include "wav.h"
+
+#ifndef HEADCACHE_BYTES
+#define HEADCACHE_BYTES     8192    //!< RAM for all cached samples
+#endif
+#ifndef HEADCACHE_CLIPS
+#define HEADCACHE_CLIPS     4       //!< maximum number of cached clips
+#endif
+#ifndef HEADCACHE_CLIP_MS
+#define HEADCACHE_CLIP_MS   200     //!< milliseconds cached per clip, if the pool allows
+#endif
+
+/*! \brief  Cached start of one clip */
+typedef struct {
+  const char *path;             //!< name of the file
+  wav_info_t  info;             //!< format of the file
+  uint16_t    rate;             //!< output rate of the cached samples
+  uint16_t   *data;             //!< 12-bit DAC codes at the output rate
+  uint16_t    samples;          //!< number of cached samples
+  uint8_t     complete;         //!< 1: the whole clip is cached
+} headcache_entry_t;
+
+/*! \brief  Cache statistics */
+typedef struct {
+  uint16_t hits;                //!< starts from the cache
+  uint16_t misses;              //!< starts of a file that is not cached
+  uint16_t handovers;           //!< file took over after the cached part
+  uint16_t late;                //!< file was opened only when the cached part ran out
+  uint16_t failed;              //!< file could not take over, the clip was cut off
+  uint16_t used;                //!< bytes of the pool in use
+} headcache_stats_t;
+
+headcache_entry_t       *headcache_alloc(const char *path, uint16_t samples);
+const headcache_entry_t *headcache_find(const char *path);
+void headcache_handover(uint8_t late, uint8_t ok);
+void headcache_clear(void);
+void headcache_get_stats(headcache_stats_t *st);
+
+#endif // HEADCACHE_H_
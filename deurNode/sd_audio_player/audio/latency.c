@@ -0,0 +1,179 @@
+/*!
+ *  \file    latency.c
+ *  \brief   Trigger-to-first-sample latency measurement
+ *
+ *  \details latency_mark() may be called from the main loop and from
+ *           interrupts; the timer is read and the statistics are updated
+ *           with interrupts disabled.
+ */
+#include "latency.h"
+
+#include <stdio.h>
+#include <avr/io.h>
+#include <util/atomic.h>
+
+#define CYCLES_PER_US   (F_CPU / 1000000UL)
+
+static uint32_t       t_request;                    //!< time of the last request
+static uint8_t        armed;                        //!< bit per stage not yet recorded
+static latency_stat_t stat[LATENCY_STAGES];
+
+static const char * const names[LATENCY_STAGES] = {
+  "open", "header", "buffer", "dac"
+};
+
+/*! \brief  Start the 32-bit time base
+ *
+ *  \details TCD0 must run free at the system clock, see cycles_init().
+ *           TCD1 counts its overflows through event channel 1.
+ *
+ *  \return void
+ */
+void latency_init(void)
+{
+  EVSYS.CH1MUX = EVSYS_CHMUX_TCD0_OVF_gc;
+  TCD1.CTRLB   = TC_WGMODE_NORMAL_gc;
+  TCD1.PER     = 0xFFFF;
+  TCD1.CNT     = 0;
+  TCD1.CTRLA   = TC_CLKSEL_EVCH1_gc;
+  latency_clear();
+}
+
+/*! \brief  Read the 32-bit time base
+ *
+ *  \details If TCD0 overflows between the reads of TCD1, the high word that
+ *           belongs to the low word is taken.
+ *
+ *  \return system clock cycles
+ */
+uint32_t latency_now(void)
+{
+  uint16_t hi, lo, hi2;
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    hi  = TCD1.CNT;
+    lo  = TCD0.CNT;
+    hi2 = TCD1.CNT;
+  }
+  if (hi != hi2 && lo < 0x8000) hi = hi2;
+
+  return ((uint32_t) hi << 16) | lo;
+}
+
+/*! \brief  Timestamp a play request and arm all stages
+ *
+ *  \return void
+ */
+void latency_request(void)
+{
+  uint32_t t = latency_now();
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    t_request = t;
+    armed     = (1 << LATENCY_STAGES) - 1;
+  }
+}
+
+/*! \brief  Record a stage of the last request
+ *
+ *  \param  stage    LATENCY_OPEN .. LATENCY_DAC
+ *
+ *  \details Only the first mark of a stage after a request is recorded.
+ *
+ *  \return void
+ */
+void latency_mark(uint8_t stage)
+{
+  latency_stat_t *s = &stat[stage];
+  uint32_t        us;
+  uint16_t        v;
+  uint8_t         bin = 0;
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if ( armed & (1 << stage) ) {
+      armed &= ~(1 << stage);
+      us = (latency_now() - t_request) / CYCLES_PER_US;
+
+      if (s->count == 0 || us < s->min) s->min = us;
+      if (us > s->max) s->max = us;
+      s->sum += us;
+      s->count++;
+
+      v = us >> 10 > 0xFFFF ? 0xFFFF : us >> 10;
+      while (v && bin < LATENCY_BINS - 1) {
+        v >>= 1;
+        bin++;
+      }
+      s->hist[bin]++;
+    }
+  }
+}
+
+/*! \brief  Do not record a stage for the last request
+ *
+ *  \param  stage    LATENCY_OPEN .. LATENCY_DAC
+ *
+ *  \details For example the open and the header of a clip that starts from
+ *           the RAM cache.
+ *
+ *  \return void
+ */
+void latency_skip(uint8_t stage)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    armed &= ~(1 << stage);
+  }
+}
+
+/*! \brief  Get a copy of the statistics of a stage
+ *
+ *  \param  stage    LATENCY_OPEN .. LATENCY_DAC
+ *  \param  st       pointer to store the statistics
+ *
+ *  \return void
+ */
+void latency_get(uint8_t stage, latency_stat_t *st)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    *st = stat[stage];
+  }
+}
+
+/*! \brief  Clear the statistics of all stages
+ *
+ *  \return void
+ */
+void latency_clear(void)
+{
+  uint8_t i, b;
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    armed = 0;
+    for (i = 0; i < LATENCY_STAGES; i++) {
+      stat[i].min = stat[i].max = stat[i].sum = 0;
+      stat[i].count = 0;
+      for (b = 0; b < LATENCY_BINS; b++) stat[i].hist[b] = 0;
+    }
+  }
+}
+
+/*! \brief  Print the statistics of all stages on stdout (serialF0)
+ *
+ *  \return void
+ */
+void latency_print(void)
+{
+  latency_stat_t s;
+  uint8_t        i, b;
+
+  printf("Latency [us]   n      min      avg      max   hist <1 1 2 4 8 16 32 64 ms\n");
+  for (i = 0; i < LATENCY_STAGES; i++) {
+    latency_get(i, &s);
+    printf("%-8s %6u %8lu %8lu %8lu  ", names[i], s.count,
+           s.min, s.count ? s.sum / s.count : 0, s.max);
+    for (b = 0; b < LATENCY_BINS; b++) {
+      printf(" %u", s.hist[b]);
+    }
+    printf("\n");
+  }
+}
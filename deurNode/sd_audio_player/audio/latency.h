@@ -0,0 +1,67 @@
+/*!
+ *  \file    latency.h
+ *  \brief   Trigger-to-first-sample latency measurement
+ *
+ *  \details A play request is timestamped by latency_request(). The player
+ *           marks the stages of the start with LATENCY_MARK(); each stage
+ *           is recorded once per request as the time since the request:
+ *           - LATENCY_OPEN:   file opened
+ *           - LATENCY_HEADER: WAV header parsed
+ *           - LATENCY_BUFFER: first ring slot ready
+ *           - LATENCY_DAC:    first sample written to the DAC, or with DMA
+ *                             output the first slot claimed for the DAC
+ *           .
+ *           Per stage the minimum, average, maximum and a histogram are kept
+ *           and can be printed with latency_print().
+ *
+ *           The time base is a 32-bit counter at the system clock: TCD0 (see
+ *           cycles.h) counts the low 16 bits and its overflow clocks TCD1
+ *           through event channel 1. The counter wraps after 134 s at 32 MHz.
+ *           The stages are only marked when AUDIO_LATENCY is 1.
+ */
+#ifndef LATENCY_H_
+#define LATENCY_H_
+
+#include <stdint.h>
+
+#ifndef AUDIO_LATENCY
+#define AUDIO_LATENCY   1       //!< 1: measure the start latency
+#endif
+
+#define LATENCY_OPEN    0       //!< stage: file opened
+#define LATENCY_HEADER  1       //!< stage: header parsed
+#define LATENCY_BUFFER  2       //!< stage: first ring slot ready
+#define LATENCY_DAC     3       //!< stage: first sample at the DAC
+#define LATENCY_STAGES  4
+
+#define LATENCY_BINS    8       //!< histogram bins: <1, 1-2, 2-4, .. 32-64, >=64 (units of 1024 us)
+
+/*! \brief  Statistics of one stage, in microseconds */
+typedef struct {
+  uint32_t min;                 //!< shortest time since the request
+  uint32_t max;                 //!< longest time since the request
+  uint32_t sum;                 //!< sum of all times
+  uint16_t count;               //!< number of requests that reached the stage
+  uint16_t hist[LATENCY_BINS];  //!< number of times per bin
+} latency_stat_t;
+
+void     latency_init(void);
+uint32_t latency_now(void);
+void     latency_request(void);
+void     latency_mark(uint8_t stage);
+void     latency_skip(uint8_t stage);
+void     latency_get(uint8_t stage, latency_stat_t *st);
+void     latency_clear(void);
+void     latency_print(void);
+
+#if AUDIO_LATENCY
+#define LATENCY_REQUEST()       latency_request()           //!< timestamp a play request
+#define LATENCY_MARK(s)         latency_mark(s)             //!< record stage s of the request
+#define LATENCY_SKIP(s)         latency_skip(s)             //!< stage s is not part of this start
+#else
+#define LATENCY_REQUEST()
+#define LATENCY_MARK(s)
+#define LATENCY_SKIP(s)
+#endif
+
+#endif // LATENCY_H_
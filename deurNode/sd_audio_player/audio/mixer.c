@@ -0,0 +1,364 @@
+/*!
+ *  \file    mixer.c
+ *  \brief   Software mixer for overlapping sounds
+ *
+ *  \details The first active voice with unity gain renders straight into
+ *           the output block, so a single stream costs no mixing at all.
+ *           Every other voice renders into a scratch block that is added
+ *           to the output. The loops for unity and scaled gain are separate,
+ *           so there is no test on the gain per sample. A voice with a
+ *           running ramp is scaled by gain_apply() first. The sum is limited
+ *           to the DAC range once, after all voices are added, so the order
+ *           of the voices does not change the result.
+ */
+#include "mixer.h"
+
+/*! \brief  State of one voice */
+typedef struct {
+  mixer_source_t src;           //!< source, 0: voice not active
+  void          *ctx;           //!< context of the source
+  gain_ramp_t    gain;          //!< gain with its ramp
+  uint8_t        stop;          //!< 1: stop at the end of the ramp
+} voice_t;
+
+static voice_t  voices[MIXER_VOICES];
+static uint16_t scratch[MIXER_BLOCK];           //!< block of a voice before mixing
+static cycles_t mix_load[MIXER_VOICES];         //!< cycles per number of active voices
+static uint32_t mix_samples[MIXER_VOICES];      //!< output samples per number of active voices
+
+/*! \brief  Add a voice block to the output block
+ *
+ *  \param  dst      output block, the first filled samples are valid
+ *  \param  src      voice block
+ *  \param  k        samples in the voice block
+ *  \param  filled   valid samples in the output block
+ *  \param  gain     gain of the voice
+ *
+ *  \details The sums are kept as int16_t and may leave the DAC range; they
+ *           are limited once, after the last voice, by limit().
+ *
+ *  \return void
+ */
+static void add(uint16_t *dst, const uint16_t *src, uint16_t k, uint16_t filled, uint16_t gain)
+{
+  uint16_t i, m = k < filled ? k : filled;
+
+  if (gain == MIXER_UNITY) {
+    for (i = 0; i < m; i++) {
+      dst[i] += src[i] - MIXER_MID;
+    }
+    for (; i < k; i++) {
+      dst[i] = src[i];
+    }
+  } else {
+    for (i = 0; i < m; i++) {
+      dst[i] += (int16_t) (((int32_t) ((int16_t) src[i] - MIXER_MID) * gain) >> 15);
+    }
+    for (; i < k; i++) {
+      dst[i] = MIXER_MID + (int16_t) (((int32_t) ((int16_t) src[i] - MIXER_MID) * gain) >> 15);
+    }
+  }
+}
+
+/*! \brief  Limit the mixed block to the DAC range
+ *
+ *  \param  dst      output block with int16_t sums
+ *  \param  n        number of samples
+ *
+ *  \return void
+ */
+static void limit(uint16_t *dst, uint16_t n)
+{
+  int16_t  s;
+  uint16_t i;
+
+  for (i = 0; i < n; i++) {
+    s = dst[i];
+    if (s < 0)         dst[i] = 0;
+    else if (s > 4095) dst[i] = 4095;
+  }
+}
+
+/*! \brief  Start a voice
+ *
+ *  \param  voice    0 .. MIXER_VOICES-1, a playing voice is replaced
+ *  \param  src      source of the samples
+ *  \param  ctx      context passed to the source
+ *  \param  gain     Q15, MIXER_UNITY is 1.0
+ *
+ *  \return 1 on success, 0 for an invalid voice
+ */
+uint8_t mixer_start(uint8_t voice, mixer_source_t src, void *ctx, uint16_t gain)
+{
+  if (voice >= MIXER_VOICES) return 0;
+
+  voices[voice].ctx  = ctx;
+  voices[voice].stop = 0;
+  gain_init(&voices[voice].gain, gain);
+  voices[voice].src  = src;
+
+  return 1;
+}
+
+/*! \brief  Find a voice that is not active
+ *
+ *  \param  first    lowest voice to consider
+ *
+ *  \return the voice, MIXER_NONE if all are active
+ */
+uint8_t mixer_free_voice(uint8_t first)
+{
+  uint8_t i;
+
+  for (i = first; i < MIXER_VOICES; i++) {
+    if ( !voices[i].src ) return i;
+  }
+
+  return MIXER_NONE;
+}
+
+/*! \brief  Stop a voice
+ *
+ *  \param  voice    0 .. MIXER_VOICES-1
+ *
+ *  \details The source is not called any more. The output jumps, use
+ *           mixer_fade_out() to stop without a click.
+ *
+ *  \return void
+ */
+void mixer_stop(uint8_t voice)
+{
+  if (voice < MIXER_VOICES) voices[voice].src = 0;
+}
+
+/*! \brief  Stop all voices
+ *
+ *  \return void
+ */
+void mixer_stop_all(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < MIXER_VOICES; i++) voices[i].src = 0;
+}
+
+/*! \brief  Change the gain of a voice with a ramp of MIXER_RAMP samples
+ *
+ *  \param  voice    0 .. MIXER_VOICES-1
+ *  \param  gain     Q15, MIXER_UNITY is 1.0
+ *
+ *  \return void
+ */
+void mixer_set_gain(uint8_t voice, uint16_t gain)
+{
+  mixer_ramp(voice, gain, MIXER_RAMP);
+}
+
+/*! \brief  Change the gain of a voice with a linear ramp
+ *
+ *  \param  voice    0 .. MIXER_VOICES-1
+ *  \param  gain     Q15 gain at the end of the ramp
+ *  \param  samples  length of the ramp, 0 to change at once
+ *
+ *  \return void
+ */
+void mixer_ramp(uint8_t voice, uint16_t gain, uint16_t samples)
+{
+  if (voice < MIXER_VOICES) gain_set(&voices[voice].gain, gain, samples);
+}
+
+/*! \brief  Let a voice that was just started rise from silence
+ *
+ *  \param  voice    0 .. MIXER_VOICES-1
+ *  \param  samples  length of the ramp to the gain given to mixer_start()
+ *
+ *  \return void
+ */
+void mixer_fade_in(uint8_t voice, uint16_t samples)
+{
+  gain_ramp_t *g;
+  uint16_t     target;
+
+  if (voice >= MIXER_VOICES || samples == 0) return;
+
+  g      = &voices[voice].gain;
+  target = g->target;
+  gain_init(g, 0);
+  gain_set(g, target, samples);
+}
+
+/*! \brief  Fade a voice to silence and stop it
+ *
+ *  \param  voice    0 .. MIXER_VOICES-1
+ *  \param  samples  length of the ramp, 0 to stop at once
+ *
+ *  \return void
+ */
+void mixer_fade_out(uint8_t voice, uint16_t samples)
+{
+  if ( !mixer_active(voice) ) return;
+
+  if (samples == 0) {
+    mixer_stop(voice);
+  } else {
+    gain_set(&voices[voice].gain, 0, samples);
+    voices[voice].stop = 1;
+  }
+}
+
+/*! \brief  Test if the gain of a voice is changing
+ *
+ *  \param  voice    0 .. MIXER_VOICES-1
+ *
+ *  \return 1 while a ramp runs, 0 otherwise
+ */
+uint8_t mixer_ramping(uint8_t voice)
+{
+  return voice < MIXER_VOICES && gain_ramping(&voices[voice].gain);
+}
+
+/*! \brief  Test if a voice is active
+ *
+ *  \param  voice    0 .. MIXER_VOICES-1
+ *
+ *  \return 1 if the voice has a source, 0 otherwise
+ */
+uint8_t mixer_active(uint8_t voice)
+{
+  return voice < MIXER_VOICES && voices[voice].src != 0;
+}
+
+/*! \brief  Count the active voices
+ *
+ *  \return number of active voices
+ */
+uint8_t mixer_count(void)
+{
+  uint8_t i, n = 0;
+
+  for (i = 0; i < MIXER_VOICES; i++) {
+    if (voices[i].src) n++;
+  }
+
+  return n;
+}
+
+/*! \brief  Mix a block of all active voices
+ *
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples wanted, at most MIXER_BLOCK are made
+ *
+ *  \details Voices whose source ends or whose fade-out is complete are
+ *           stopped.
+ *
+ *  \return number of samples made: the most of any voice, 0 if no voice is
+ *          active
+ */
+uint16_t mixer_render(uint16_t *dst, uint16_t n)
+{
+  voice_t *v;
+  uint16_t filled = 0, k;
+  uint8_t  i, active = 0, mixed = 0;
+#if AUDIO_PROFILE
+  uint16_t spent = 0, t;
+#endif
+
+  if (n > MIXER_BLOCK) n = MIXER_BLOCK;
+
+  for (i = 0; i < MIXER_VOICES; i++) {
+    v = &voices[i];
+    if ( !v->src ) continue;
+    active++;
+
+    if (filled == 0) {
+      k = v->src(v->ctx, dst, n);       // straight into the output
+#if AUDIO_PROFILE
+      t = cycles_now();
+#endif
+      if ( gain_ramping(&v->gain) || gain_now(&v->gain) != MIXER_UNITY ) {
+        gain_apply(&v->gain, dst, k);
+        mixed = 1;
+      }
+      filled = k;
+    } else {
+      k = v->src(v->ctx, scratch, n);
+#if AUDIO_PROFILE
+      t = cycles_now();
+#endif
+      if ( gain_ramping(&v->gain) ) {   // scaled once: by the ramp or by add()
+        gain_apply(&v->gain, scratch, k);
+        add(dst, scratch, k, filled, MIXER_UNITY);
+      } else {
+        add(dst, scratch, k, filled, gain_now(&v->gain));
+      }
+      if (k > filled) filled = k;
+      mixed = 1;
+    }
+#if AUDIO_PROFILE
+    spent += cycles_now() - t;
+#endif
+    if ( k < n || (v->stop && !gain_ramping(&v->gain)) ) {
+      v->src = 0;                       // source has ended or is faded out
+    }
+  }
+
+  if (mixed) {
+#if AUDIO_PROFILE
+    t = cycles_now();
+#endif
+    limit(dst, filled);
+#if AUDIO_PROFILE
+    spent += cycles_now() - t;
+#endif
+  }
+
+#if AUDIO_PROFILE
+  if (active) {
+    cycles_add(&mix_load[active - 1], spent);
+    mix_samples[active - 1] += filled;
+  }
+#endif
+
+  return filled;
+}
+
+/*! \brief  Source that plays 12-bit DAC codes from RAM
+ *
+ *  \param  ctx      pointer to a mixer_ram_t
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples wanted
+ *
+ *  \return number of samples made, less than n at the end of the data
+ */
+uint16_t mixer_ram_source(void *ctx, uint16_t *dst, uint16_t n)
+{
+  mixer_ram_t *r = ctx;
+  uint16_t     i;
+
+  if (n > r->left) n = r->left;
+  for (i = 0; i < n; i++) {
+    dst[i] = r->data[i];
+  }
+  r->data += n;
+  r->left -= n;
+
+  return n;
+}
+
+/*! \brief  Get the cycles spent mixing with a number of active voices
+ *
+ *  \param  n        number of active voices, 1 .. MIXER_VOICES
+ *  \param  load     pointer to store the measurement
+ *  \param  samples  pointer to store the number of output samples
+ *
+ *  \details The cycles per sample are load->total / *samples. With one voice
+ *           at unity gain nothing is mixed. Only measured when AUDIO_PROFILE
+ *           is 1.
+ *
+ *  \return void
+ */
+void mixer_get_load(uint8_t n, cycles_t *load, uint32_t *samples)
+{
+  cycles_get(&mix_load[n - 1], load);
+  *samples = mix_samples[n - 1];
+}
@@ -0,0 +1,78 @@
+/*!
+ *  \file    mixer.h
+ *  \brief   Software mixer for overlapping sounds
+ *
+ *  \details The mixer has MIXER_VOICES voices. Each active voice has a
+ *           source: a function that makes 12-bit DAC codes at the output
+ *           rate, for example a file stream of the player or samples in RAM
+ *           (mixer_ram_source()). mixer_render() takes a block from every
+ *           active voice, scales it around mid-scale with the gain of the
+ *           voice and adds it with saturation to 0..4095.
+ *
+ *           Gain changes are linear ramps (gain.h), so a voice can be faded
+ *           in and out without a click; see mixer_fade_in() and
+ *           mixer_fade_out().
+ *
+ *           A voice ends when its source returns less samples than asked.
+ *           Voices are started and stopped between two blocks, the other
+ *           voices are not affected. All functions are called from the main
+ *           loop.
+ *
+ *           With AUDIO_PROFILE set to 1 the cycles of the mixing (not of the
+ *           sources) are measured per number of active voices, see
+ *           mixer_get_load().
+ */
+#ifndef MIXER_H_
+#define MIXER_H_
+
+#include <stdint.h>
+#include "cycles.h"
+#include "gain.h"
+
+#ifndef MIXER_VOICES
+#define MIXER_VOICES    4       //!< number of voices
+#endif
+#ifndef MIXER_BLOCK
+#define MIXER_BLOCK     256     //!< most samples taken from a source at once
+#endif
+
+#ifndef MIXER_RAMP
+#define MIXER_RAMP      256     //!< samples of the ramp of mixer_set_gain()
+#endif
+
+#define MIXER_UNITY     GAIN_UNITY  //!< gain 1.0 (Q15); gains up to 0xFFFF amplify
+#define MIXER_MID       GAIN_MID    //!< DAC code of silence
+#define MIXER_NONE      0xFF    //!< no voice
+
+/*! \brief  Source of a voice
+ *
+ *  \param  ctx      context given to mixer_start()
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples wanted, at least 1
+ *
+ *  \return number of samples made, less than n when the source has ended
+ */
+typedef uint16_t (*mixer_source_t)(void *ctx, uint16_t *dst, uint16_t n);
+
+/*! \brief  Context of mixer_ram_source() */
+typedef struct {
+  const uint16_t *data;         //!< next 12-bit DAC code
+  uint16_t        left;         //!< codes left
+} mixer_ram_t;
+
+uint8_t  mixer_start(uint8_t voice, mixer_source_t src, void *ctx, uint16_t gain);
+uint8_t  mixer_free_voice(uint8_t first);
+void     mixer_stop(uint8_t voice);
+void     mixer_stop_all(void);
+void     mixer_set_gain(uint8_t voice, uint16_t gain);
+void     mixer_ramp(uint8_t voice, uint16_t gain, uint16_t samples);
+void     mixer_fade_in(uint8_t voice, uint16_t samples);
+void     mixer_fade_out(uint8_t voice, uint16_t samples);
+uint8_t  mixer_ramping(uint8_t voice);
+uint8_t  mixer_active(uint8_t voice);
+uint8_t  mixer_count(void);
+uint16_t mixer_render(uint16_t *dst, uint16_t n);
+uint16_t mixer_ram_source(void *ctx, uint16_t *dst, uint16_t n);
+void     mixer_get_load(uint8_t n, cycles_t *load, uint32_t *samples);
+
+#endif // MIXER_H_
@@ -0,0 +1,108 @@
+/*!
+ *  \file    pcm.c
+ *  \brief   PCM decode kernels to 12-bit DAC codes
+ *
+ *  \details 16-bit samples are made offset binary by inverting the sign bit,
+ *           so all kernels work with unsigned values and mid-scale (0x8000)
+ *           becomes DAC code 2048. Stereo frames are averaged; for 16-bit the
+ *           two halves are added, which keeps the sum within 16 bits.
+ */
+#include "pcm.h"
+
+static cycles_t pcm_load;               //!< cycles in the kernels
+static uint32_t pcm_bytes;              //!< bytes decoded
+
+static void pcm_u8_mono(const uint8_t *in, uint16_t *out, uint16_t n)
+{
+  do {
+    *out++ = (uint16_t) *in++ << 4;
+  } while (--n);
+}
+
+static void pcm_s16_mono(const uint8_t *in, uint16_t *out, uint16_t n)
+{
+  const uint16_t *s = (const uint16_t *) in;
+
+  do {
+    *out++ = (*s++ ^ 0x8000) >> 4;
+  } while (--n);
+}
+
+static void pcm_u8_stereo(const uint8_t *in, uint16_t *out, uint16_t n)
+{
+  do {
+    *out++ = ((uint16_t) in[0] + in[1]) << 3;
+    in += 2;
+  } while (--n);
+}
+
+static void pcm_s16_stereo(const uint8_t *in, uint16_t *out, uint16_t n)
+{
+  const uint16_t *s = (const uint16_t *) in;
+
+  do {
+    *out++ = (((s[0] ^ 0x8000) >> 1) + ((s[1] ^ 0x8000) >> 1)) >> 4;
+    s += 2;
+  } while (--n);
+}
+
+/*! \brief  Select the kernel for the format of a file
+ *
+ *  \param  dec      pointer to store the decoder
+ *  \param  info     format of the file
+ *
+ *  \return 1 on success, 0 if the format is not supported
+ */
+uint8_t pcm_select(pcm_decoder_t *dec, const wav_info_t *info)
+{
+  if (info->format != WAV_FORMAT_PCM) return 0;
+
+  if (info->bits == 8 && info->channels == 1) {
+    dec->kernel = pcm_u8_mono;
+  } else if (info->bits == 16 && info->channels == 1) {
+    dec->kernel = pcm_s16_mono;
+  } else if (info->bits == 8 && info->channels == 2) {
+    dec->kernel = pcm_u8_stereo;
+  } else if (info->bits == 16 && info->channels == 2) {
+    dec->kernel = pcm_s16_stereo;
+  } else {
+    return 0;
+  }
+  dec->frame_size = (info->bits / 8) * info->channels;
+
+  return 1;
+}
+
+/*! \brief  Decode a block of frames with the selected kernel
+ *
+ *  \param  dec      decoder selected with pcm_select()
+ *  \param  in       frames in the file format
+ *  \param  out      pointer to store the 12-bit DAC codes
+ *  \param  n        number of frames, at least 1
+ *
+ *  \return void
+ */
+void pcm_decode(const pcm_decoder_t *dec, const uint8_t *in, uint16_t *out, uint16_t n)
+{
+  CYCLES_BEGIN(t);
+  dec->kernel(in, out, n);
+  CYCLES_END(pcm_load, t);
+  pcm_bytes += (uint32_t) n * dec->frame_size;
+}
+
+/*! \brief  Get the cycles spent in the kernels
+ *
+ *  \param  load     pointer to store the measurement
+ *  \param  bytes    pointer to store the number of input bytes decoded
+ *
+ *  \details The throughput is *bytes / load->total bytes per cycle. Only
+ *           measured when AUDIO_PROFILE is 1. Interrupts during a kernel are
+ *           included.
+ *
+ *  \return void
+ */
+void pcm_get_load(cycles_t *load, uint32_t *bytes)
+{
+  cycles_get(&pcm_load, load);
+  *bytes = pcm_bytes;
+}
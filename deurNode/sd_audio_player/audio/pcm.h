@@ -0,0 +1,42 @@
+/*!
+ *  \file    pcm.h
+ *  \brief   PCM decode kernels to 12-bit DAC codes
+ *
+ *  \details One kernel per sample format is selected once, when a file is
+ *           opened. A kernel converts a block of frames in one loop without
+ *           any test on the format per sample:
+ *           - 8-bit unsigned mono
+ *           - 16-bit signed little endian mono
+ *           - 8-bit unsigned stereo, averaged to mono
+ *           - 16-bit signed little endian stereo, averaged to mono
+ *           .
+ *           With AUDIO_PROFILE set to 1 the cycles in the kernels are
+ *           measured by pcm_decode(), see pcm_get_load(). tools/pcmbench.c
+ *           times every kernel on its own on the host.
+ */
+#ifndef PCM_H_
+#define PCM_H_
+
+#include <stdint.h>
+#include "wav.h"
+#include "cycles.h"
+
+/*! \brief  Decode kernel
+ *
+ *  \param  in       frames in the file format
+ *  \param  out      pointer to store the 12-bit DAC codes
+ *  \param  n        number of frames, at least 1
+ */
+typedef void (*pcm_kernel_t)(const uint8_t *in, uint16_t *out, uint16_t n);
+
+/*! \brief  Selected decoder for one file */
+typedef struct {
+  pcm_kernel_t kernel;                  //!< kernel for the format
+  uint8_t      frame_size;              //!< bytes per frame in the file
+} pcm_decoder_t;
+
+uint8_t pcm_select(pcm_decoder_t *dec, const wav_info_t *info);
+void    pcm_decode(const pcm_decoder_t *dec, const uint8_t *in, uint16_t *out, uint16_t n);
+void    pcm_get_load(cycles_t *load, uint32_t *bytes);
+
+#endif // PCM_H_
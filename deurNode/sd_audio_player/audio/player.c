@@ -0,0 +1,1456 @@
+/*!
+ *  \file    player.c
+ *  \brief   Buffered WAV playback engine for the door node
+ *
+ *  \details The samples are passed from the main loop to the output
+ *           interrupt through a lock-free ring buffer (ring.h). The main loop
+ *           reads the file straight into free ring memory and publishes it in
+ *           whole slots; the interrupt only consumes. No interrupts have to
+ *           be disabled during playback.
+ *
+ *           Two tracks (open files with their decoder) are kept: the one
+ *           being decoded and the next one from the queue. At the end of a
+ *           track the decoding continues with the next track in the same
+ *           ring slot, so there is no gap between the files.
+ *
+ *           This file has no register access. The output driver (dac.c)
+ *           either takes single samples with player_next_sample() or whole
+ *           slots with player_claim_block() and player_release_block(),
+ *           so the engine can also be run on a PC against an image of the
+ *           SD-card: tools/playimg.c with the shims in tools/host.
+ */
+#include "player.h"
+#include "ring.h"
+#include "wav.h"
+#include "resample.h"
+#include "pcm.h"
+#include "adpcm.h"
+#include "headcache.h"
+#include "latency.h"
+#include "mixer.h"
+#include "gain.h"
+#include "flashbank.h"
+#include "soundbank.h"
+#include "clipindex.h"
+#include "../diskio.h"
+
+#include <string.h>
+#include <util/atomic.h>
+
+#define PLAYER_IDLE      0      //!< no file open
+#define PLAYER_PLAYING   1      //!< file open, ring is refilled
+#define PLAYER_DRAINING  2      //!< end of the last file, remaining samples are played
+
+#define SLOT_LEN         (1 << (PLAYER_SLOT_SHIFT - 1))     //!< samples per slot
+#define QUEUE_MASK       (PLAYER_QUEUE_LEN - 1)
+#define CLMT_LEN         (PLAYER_EXTENTS ? 2 * PLAYER_EXTENTS + 2 : 4)   //!< DWORDs of a cluster link map
+
+typedef struct track_s track_t;
+
+/*! \brief  An open file with its decoder */
+struct track_s {
+  FIL            file;                                      //!< the file
+  wav_info_t     info;                                      //!< format of the file
+  uint16_t     (*fill)(track_t *t, uint16_t *dst, uint16_t n);   //!< decoder for the format
+  pcm_decoder_t  dec;                                       //!< PCM kernel for the format
+  adpcm_t        adpcm;                                     //!< ADPCM decoder
+  uint32_t       data_left;                                 //!< bytes of the data chunk not yet read
+  LBA_t          sector;                                    //!< next sector read with disk_read(), 0: f_read()
+  DWORD          run;                                       //!< sectors left in the extent of sector
+  const DWORD   *ext;                                       //!< next fragment in clmt[], 0: none
+  uint16_t       head;                                      //!< bytes to read with f_read() up to a sector boundary
+  BYTE           drive;                                     //!< physical drive of sector
+  DWORD          clmt[CLMT_LEN];                            //!< cluster link map: the extents of the file
+  uint16_t       pos, len;                                  //!< decoded and valid bytes in buf[]
+  uint8_t        buf[PLAYER_IN_LEN];                        //!< block read from the file
+};
+
+static track_t           tracks[2];                         //!< current and next track of the main voice
+static track_t           overlays[PLAYER_OVERLAYS];         //!< files played by other voices
+static uint8_t           overlay_voice[PLAYER_OVERLAYS];    //!< voice of an overlay, 0: free
+static flashbank_clip_t  flash_clips[MIXER_VOICES];         //!< flash clip per voice
+static track_t          *cur = &tracks[0];                  //!< track being decoded
+static uint8_t           next_ready;                        //!< 1: the other track is open and primed
+static const char       *queue[PLAYER_QUEUE_LEN];           //!< files to play after the current one
+static uint8_t           q_head, q_tail;
+
+static resample_t        rs;                                //!< converter to PLAYER_OUT_RATE
+static uint8_t           resampling;                        //!< 1: file rate differs from the output rate
+static uint8_t           in_end;                            //!< 1: converter input is complete
+static uint16_t          out_rate = PLAYER_OUT_RATE;        //!< rate of the output
+static uint16_t          tail = DAC_MID;                    //!< last sample made
+static uint8_t           ring_buf[PLAYER_RING_SLOTS << PLAYER_SLOT_SHIFT];
+static ring_t            ring;                              //!< 12-bit DAC codes
+static volatile uint8_t  state = PLAYER_IDLE;
+
+static uint16_t          last_sample = DAC_MID;             //!< repeated on an underrun
+static uint16_t          silence[PLAYER_SILENCE_LEN];       //!< block output on an underrun
+static uint8_t           claimed;                           //!< b0/b1: silence block claimed, in order
+static uint8_t           claim_in, claim_out;
+
+static const headcache_entry_t *hc;                        //!< cached clip being played, 0: none
+static const uint16_t   *hc_ptr;                            //!< next cached sample
+static uint16_t          hc_left;                           //!< cached samples not yet in the ring
+static uint8_t           hc_open;                           //!< file of the cached clip: 0 not opened, 1 open, 2 failed
+
+static uint16_t          main_gain = MIXER_UNITY;           //!< gain of the main voice
+static uint8_t           main_open;                         //!< 1: files of the main voice are open
+static const char       *pending;                           //!< file that preempts the main voice
+static uint16_t          level = DAC_MID;                   //!< last sample mixed
+static uint16_t          hold;                              //!< level of the ramp to mid-scale
+static uint8_t           released;                          //!< 1: ramp to mid-scale done or running
+
+static player_stats_t    stats;
+static uint32_t          read_bytes;                        //!< bytes read from the files
+#if AUDIO_PROFILE
+static cycles_t          read_load;                         //!< cycles in the reads of the files
+#endif
+static uint8_t           gap_open;                          //!< 1: track change not yet committed
+static uint16_t          gap_mark;                          //!< underruns at the track change
+
+/*! \brief  Get the track that is not being decoded
+ *
+ *  \return pointer to the other track
+ */
+static inline track_t *other(void)
+{
+  return cur == &tracks[0] ? &tracks[1] : &tracks[0];
+}
+
+/*! \brief  Read whole sectors along the extents of a track
+ *
+ *  \param  t        track with sector set
+ *  \param  len      number of bytes, at most PLAYER_IN_LEN
+ *
+ *  \details The sectors are read with disk_read() into the buffer, as many
+ *           per call as fit in one extent. At the end of an extent the next
+ *           fragment of the cluster link map is taken.
+ *
+ *  \return FR_OK, FR_INT_ERR past the last extent or FR_DISK_ERR
+ */
+static FRESULT read_sectors(track_t *t, uint16_t len)
+{
+  FATFS   *fs = t->file.obj.fs;
+  uint16_t done = 0;
+  DWORD    n;
+
+  while (done < len) {
+    if (t->run == 0) {                  // next fragment: clusters, first cluster
+      if ( !t->ext || !t->ext[0] ) return FR_INT_ERR;
+      t->sector = fs->database + (LBA_t) (t->ext[1] - 2) * fs->csize;
+      t->run    = t->ext[0] * fs->csize;
+      t->ext   += 2;
+    }
+    n = (len - done + FF_MAX_SS - 1) / FF_MAX_SS;
+    if (n > t->run) n = t->run;
+    if ( disk_read(t->drive, t->buf + done, t->sector, n) != RES_OK ) {
+      return FR_DISK_ERR;
+    }
+    t->sector += n;
+    t->run    -= n;
+    done      += n * FF_MAX_SS;
+  }
+
+  return FR_OK;
+}
+
+/*! \brief  Read the next block of the data chunk into the buffer of a track
+ *
+ *  \param  t        track
+ *  \param  len      maximum number of bytes
+ *
+ *  \details Along the extents whole sectors are read, the last one may hold
+ *           bytes after the data. Up to the first sector boundary, and for
+ *           files without extents, f_read() is used.
+ *
+ *  \return number of bytes read, 0 at the end of the data or on an error
+ */
+static uint16_t read_block(track_t *t, uint16_t len)
+{
+#if AUDIO_PROFILE
+  uint32_t start = latency_now();       // 32 bits: a read of several sectors can take over 65535 cycles
+#endif
+  UINT br;
+
+  if (len > t->data_left) len = t->data_left;
+  if (len == 0) return 0;
+  if (t->sector && t->head == 0) {
+    if ( read_sectors(t, len) != FR_OK ) {
+      return 0;
+    }
+    br = len;
+    stats.direct++;
+  } else {
+    if (t->sector && len > t->head) len = t->head;
+    if ( f_read(&t->file, t->buf, len, &br) != FR_OK ) {
+      return 0;
+    }
+    if (t->sector) t->head -= br;
+  }
+  t->data_left -= br;
+  read_bytes   += br;
+  stats.blocks++;
+#if AUDIO_PROFILE
+  start = latency_now() - start;
+  read_load.total += start;
+  read_load.count++;
+  if (start > read_load.max) read_load.max = start > 0xFFFF ? 0xFFFF : start;
+#endif
+
+  return br;
+}
+
+/*! \brief  Read the next PCM block of a track */
+static void next_pcm(track_t *t)
+{
+  t->len  = read_block(t, sizeof(t->buf));
+  t->len -= t->len % t->dec.frame_size;       // drop a partial last frame
+  t->pos  = 0;
+}
+
+/*! \brief  Decode PCM samples from a track
+ *
+ *  \param  t        track
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples to make
+ *
+ *  \details The file is read in blocks of PLAYER_IN_LEN bytes. The kernel
+ *           selected when the track was opened converts as many whole frames
+ *           of a block as fit in dst; the rest of the block is kept for the
+ *           next call.
+ *
+ *  \return number of samples made, less than n at end of file
+ */
+static uint16_t fill_pcm(track_t *t, uint16_t *dst, uint16_t n)
+{
+  uint16_t got = 0, k;
+
+  while (got < n) {
+    if (t->pos >= t->len) {
+      next_pcm(t);
+      if (t->len == 0) break;
+    }
+
+    k = (t->len - t->pos) / t->dec.frame_size;
+    if (k > n - got) k = n - got;
+    pcm_decode(&t->dec, t->buf + t->pos, dst + got, k);
+    t->pos += k * t->dec.frame_size;
+    got    += k;
+  }
+
+  return got;
+}
+
+/*! \brief  Decode IMA ADPCM samples from a track
+ *
+ *  \param  t        track
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples to make
+ *
+ *  \details One ADPCM block at a time is read into the buffer.
+ *
+ *  \return number of samples made, less than n at end of file
+ */
+static uint16_t fill_adpcm(track_t *t, uint16_t *dst, uint16_t n)
+{
+  uint16_t got = 0;
+
+  while (got < n) {
+    if ( adpcm_done(&t->adpcm) ) {
+      adpcm_begin(&t->adpcm, t->buf, read_block(t, t->info.block_align));
+      if ( adpcm_done(&t->adpcm) ) break;
+    }
+    got += adpcm_decode(&t->adpcm, dst + got, n - got);
+  }
+
+  return got;
+}
+
+/*! \brief  Select the decoder of a track from its format
+ *
+ *  \param  t        track with the format in info
+ *
+ *  \details The track must have a rate that can be played at out_rate, any
+ *           rate if out_rate is not set yet.
+ *
+ *  \return FR_OK or FR_INVALID_PARAMETER for an unsupported format
+ */
+static FRESULT track_select(track_t *t)
+{
+  FRESULT res = FR_OK;
+
+  t->data_left = t->info.data_size;
+  if ( out_rate && t->info.sample_rate != out_rate &&
+       (PLAYER_OUT_RATE == 0 || !resample_supported(t->info.sample_rate)) ) {
+    res = FR_INVALID_PARAMETER;
+  } else if ( pcm_select(&t->dec, &t->info) ) {
+    t->fill = fill_pcm;
+  } else if ( t->info.block_align <= PLAYER_IN_LEN && adpcm_init(&t->adpcm, &t->info) ) {
+    t->fill = fill_adpcm;
+  } else {
+    res = FR_INVALID_PARAMETER;
+  }
+  t->pos = t->len = 0;                  // no block read yet
+  adpcm_begin(&t->adpcm, t->buf, 0);
+
+  return res;
+}
+
+/*! \brief  Set the extent position of a track
+ *
+ *  \param  t        track with the cluster link map of its file in cltbl
+ *  \param  pos      file offset of the next byte to read
+ *
+ *  \details The bytes up to the next sector boundary are left to f_read().
+ *           For PCM that must be whole frames; ADPCM blocks must start at a
+ *           sector boundary and be whole sectors. Otherwise, and without a
+ *           link map, the track is read with f_read() only.
+ *
+ *  \return void
+ */
+static void track_extents(track_t *t, FSIZE_t pos)
+{
+  FATFS       *fs = t->file.obj.fs;
+  const DWORD *p  = t->file.cltbl;
+  DWORD        s, n;
+
+  t->sector = 0;
+  t->head   = (FF_MAX_SS - pos % FF_MAX_SS) % FF_MAX_SS;
+  if ( !PLAYER_EXTENTS || PLAYER_IN_LEN % FF_MAX_SS || !p ) return;
+  if ( t->fill == fill_pcm ? t->head % t->dec.frame_size
+                           : t->head || t->info.block_align % FF_MAX_SS ) return;
+
+  s = (pos + t->head) / FF_MAX_SS;      // sector of the file
+  for (p++; (n = *p++ * fs->csize) != 0; p++) {   // fragments: clusters, first cluster
+    if (s < n) {
+      t->sector = fs->database + (LBA_t) (*p - 2) * fs->csize + s;
+      t->run    = n - s;
+      t->ext    = p + 1;
+      t->drive  = fs->pdrv;
+      return;
+    }
+    s -= n;
+  }
+}
+
+/*! \brief  Open a file and read its header
+ *
+ *  \param  t        track to use
+ *  \param  path     name of the file on the mounted volume
+ *
+ *  \details A file in the clip index (clipindex.h) is opened without card
+ *           access and its header is taken from the index. See
+ *           track_select() for the formats and rates. The cluster link map
+ *           of a file that is not contiguous is made here; this reads the
+ *           FAT sectors of the file once, which f_read() would do during
+ *           playback.
+ *
+ *  \return FR_OK, FR_INVALID_PARAMETER for an unsupported format or the
+ *          FatFs error code
+ */
+static FRESULT track_open(track_t *t, const char *path)
+{
+  const clipindex_entry_t *e = clipindex_find(path);
+  FRESULT                  res;
+
+  t->sector = 0;
+  if (e) {
+    t->info = e->info;
+    res = clipindex_open(&t->file, e, t->clmt);
+  } else {
+    res = f_open(&t->file, path, FA_READ);
+  }
+  if (res != FR_OK) {
+    return res;
+  }
+  LATENCY_MARK(LATENCY_OPEN);
+  if ( e || (res = wav_read_header(&t->file, &t->info)) == FR_OK ) {
+    LATENCY_MARK(LATENCY_HEADER);
+    res = track_select(t);
+  }
+  if (res != FR_OK) {
+    f_close(&t->file);
+    return res;
+  }
+  if ( PLAYER_EXTENTS && !t->file.cltbl ) {
+    t->file.cltbl = t->clmt;
+    t->clmt[0]    = CLMT_LEN;
+    if ( f_lseek(&t->file, CREATE_LINKMAP) != FR_OK ) {
+      t->file.cltbl = 0;                // too many fragments: f_read() only
+    }
+  }
+  track_extents(t, t->info.data_offset);
+
+  return FR_OK;
+}
+
+/*! \brief  Open a clip of the sound bank
+ *
+ *  \param  t        track to use
+ *  \param  id       number of the clip in the bank
+ *
+ *  \details The format comes from the index in RAM and the data is read
+ *           with disk_read() from the sector of the clip as one extent, so
+ *           nothing is read from the card here. The blocks read must be whole sectors:
+ *           PLAYER_IN_LEN and the ADPCM block size must be multiples of
+ *           SOUNDBANK_SECTOR.
+ *
+ *  \return FR_OK, FR_INVALID_PARAMETER for an unsupported format or the
+ *          result of soundbank_clip()
+ */
+static FRESULT track_open_clip(track_t *t, uint16_t id)
+{
+  LBA_t   sector;
+  FRESULT res;
+
+  t->sector = 0;
+  if ( (res = soundbank_clip(id, &t->info, &sector)) != FR_OK ) {
+    return res;
+  }
+  if ( PLAYER_IN_LEN % SOUNDBANK_SECTOR ||
+       (t->info.format != WAV_FORMAT_PCM && t->info.block_align % SOUNDBANK_SECTOR) ) {
+    return FR_INVALID_PARAMETER;
+  }
+  if ( (res = track_select(t)) == FR_OK ) {
+    t->sector = sector;
+    t->run    = (t->info.data_size + SOUNDBANK_SECTOR - 1) / SOUNDBANK_SECTOR;
+    t->ext    = 0;
+    t->head   = 0;
+    t->drive  = soundbank_drive();
+  }
+
+  return res;
+}
+
+/*! \brief  Make a track without samples
+ *
+ *  \param  t        track
+ *
+ *  \return void
+ */
+static void track_empty(track_t *t)
+{
+  t->fill           = fill_pcm;
+  t->dec.frame_size = 1;
+  t->data_left      = 0;
+  t->pos = t->len   = 0;
+}
+
+/*! \brief  Read the first block of a track that was just opened
+ *
+ *  \param  t        track
+ *
+ *  \return void
+ */
+static void track_prime(track_t *t)
+{
+  if (t->fill == fill_pcm) {
+    next_pcm(t);
+  } else {
+    adpcm_begin(&t->adpcm, t->buf, read_block(t, t->info.block_align));
+  }
+}
+
+/*! \brief  Continue a track that was just opened at a given frame
+ *
+ *  \param  t        track
+ *  \param  frame    index of the first frame to decode
+ *
+ *  \details PCM files are positioned exactly. For ADPCM the block that holds
+ *           the frame is read and the frames before it are decoded and
+ *           dropped.
+ *
+ *  \return FR_OK or the FatFs error code
+ */
+static FRESULT track_seek(track_t *t, uint32_t frame)
+{
+  uint16_t tmp[ADPCM_GROUP], k;
+  uint16_t per_block;
+  uint32_t ofs, skip = 0;
+  FRESULT  res;
+
+  if (t->fill == fill_pcm) {
+    ofs = frame * t->dec.frame_size;
+  } else {
+    per_block = adpcm_block_frames(&t->info);
+    ofs  = frame / per_block * t->info.block_align;
+    skip = frame % per_block;
+  }
+  if (ofs > t->info.data_size) ofs = t->info.data_size;
+  if ( (res = f_lseek(&t->file, t->info.data_offset + ofs)) != FR_OK ) {
+    return res;
+  }
+  track_extents(t, t->info.data_offset + ofs);
+  t->data_left = t->info.data_size - ofs;
+
+  while (skip) {
+    k = skip < ADPCM_GROUP ? skip : ADPCM_GROUP;
+    if ( (k = t->fill(t, tmp, k)) == 0 ) break;
+    skip -= k;
+  }
+
+  return FR_OK;
+}
+
+/*! \brief  Open the first playable file of the queue as the next track
+ *
+ *  \details Files that cannot be opened are skipped.
+ *
+ *  \return void
+ */
+static void prefetch(void)
+{
+  track_t *t = other();
+
+  while ( !next_ready && q_tail != q_head ) {
+    if ( track_open(t, queue[q_tail++ & QUEUE_MASK]) == FR_OK ) {
+      track_prime(t);
+      next_ready = 1;
+    } else {
+      stats.skipped++;
+    }
+  }
+}
+
+/*! \brief  Continue with the next track at the end of the current one
+ *
+ *  \param  rate     required rate of the next track, 0 for any rate
+ *
+ *  \details Opens the next track first if the prefetch has not been done.
+ *
+ *  \return 1 if the next track is now current, 0 otherwise
+ */
+static uint8_t next_track(uint32_t rate)
+{
+  prefetch();
+  if ( !next_ready || (rate && other()->info.sample_rate != rate) ) return 0;
+
+  f_close(&cur->file);
+  cur = other();
+  next_ready = 0;
+  stats.tracks++;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    gap_mark = stats.underruns;
+  }
+  gap_open = 1;
+
+  return 1;
+}
+
+/*! \brief  Set up the conversion for the rate of the current track
+ *
+ *  \return void
+ */
+static void set_rate(void)
+{
+  resampling = cur->info.sample_rate != out_rate;
+  in_end = 0;
+  if (resampling) {
+    resample_init(&rs, cur->info.sample_rate, tail);
+  }
+}
+
+/*! \brief  Decode samples, continuing with the next track at the same rate
+ *
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples to make
+ *
+ *  \return number of samples made, less than n at the end of the last track
+ *          at this rate
+ */
+static uint16_t fill(uint16_t *dst, uint16_t n)
+{
+  uint16_t got = cur->fill(cur, dst, n);
+
+  while ( got < n && next_track(cur->info.sample_rate) ) {
+    got += cur->fill(cur, dst + got, n - got);
+  }
+
+  return got;
+}
+
+/*! \brief  Open the file of the cached clip after its cached part
+ *
+ *  \details The converter and the decoder are set to the state they had
+ *           after the cached samples were made, so the file continues at the
+ *           exact next sample. A complete or failing clip gets an empty track.
+ *
+ *  \return void
+ */
+static void catch_up(void)
+{
+  uint32_t first = hc->samples;
+
+  if ( !hc->complete && track_open(cur, hc->path) == FR_OK ) {
+    resampling = cur->info.sample_rate != out_rate;
+    in_end = 0;
+    if (resampling) {
+      first = resample_start_at(&rs, cur->info.sample_rate, hc->samples, DAC_MID);
+    }
+    if ( track_seek(cur, first) == FR_OK ) {
+      hc_open = 1;
+      return;
+    }
+    f_close(&cur->file);
+  }
+  track_empty(cur);
+  resampling = 0;
+  hc_open = 2;
+}
+
+/*! \brief  Continue with the file at the end of the cached part
+ *
+ *  \return void
+ */
+static void takeover(void)
+{
+  uint8_t late = hc_open == 0;
+
+  if (late) catch_up();
+  if ( !hc->complete ) headcache_handover(late, hc_open == 1);
+  hc = 0;
+}
+
+/*! \brief  Make output samples at the output rate
+ *
+ *  \param  dst      reserved ring memory
+ *  \param  n        number of samples to make
+ *
+ *  \details The cached part of a clip is copied first. Without resampling
+ *           the samples are decoded straight into dst. Otherwise they are
+ *           decoded into the input of the converter. At a change of rate
+ *           between two tracks the converter is emptied and started again
+ *           for the new rate.
+ *
+ *  \return number of samples made, less than n at the end of the last track
+ */
+static uint16_t produce(uint16_t *dst, uint16_t n)
+{
+  uint16_t *in;
+  uint16_t  got = 0, room, k;
+
+  if (hc_left) {
+    got = hc_left < n ? hc_left : n;
+    memcpy(dst, hc_ptr, got * sizeof(uint16_t));
+    hc_ptr  += got;
+    hc_left -= got;
+    if (got == n) {
+      tail = dst[got - 1];
+      return got;
+    }
+  }
+  if (hc) takeover();
+
+  for (;;) {
+    if ( !resampling ) {
+      got += fill(dst + got, n - got);
+    } else {
+      got += resample_run(&rs, dst + got, n - got);
+      if (got < n && !in_end) {
+        in = resample_in_ptr(&rs, &room);
+        k  = fill(in, room);
+        resample_in_commit(&rs, k);
+        if (k < room) {
+          resample_flush(&rs);
+          in_end = 1;
+        }
+        continue;
+      }
+    }
+    if (got) tail = dst[got - 1];
+    if ( got == n || !next_track(0) ) break;
+    set_rate();
+  }
+
+  return got;
+}
+
+/*! \brief  Close the files of the main voice
+ *
+ *  \return void
+ */
+static void close_main(void)
+{
+  main_open = 0;
+  hc = 0;
+  hc_left = 0;
+  f_close(&cur->file);
+  if (next_ready) {
+    f_close(&other()->file);
+    next_ready = 0;
+  }
+}
+
+static FRESULT open_main(const char *path);
+
+/*! \brief  Mixer source that repeats one sample
+ *
+ *  \param  ctx      pointer to the sample
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples wanted
+ *
+ *  \return n
+ */
+static uint16_t hold_source(void *ctx, uint16_t *dst, uint16_t n)
+{
+  uint16_t v = *(const uint16_t *) ctx, i;
+
+  for (i = 0; i < n; i++) dst[i] = v;
+
+  return n;
+}
+
+/*! \brief  Start a ramp from the last sample to mid-scale
+ *
+ *  \details Called when all voices have ended. The last sample is held in a
+ *           voice that is faded out, so the output does not step.
+ *
+ *  \return 1 if the ramp was started, 0 if it is not needed
+ */
+static uint8_t release(void)
+{
+  uint8_t v;
+
+  if (released || level == DAC_MID || PLAYER_FADE_LEN == 0) return 0;
+  released = 1;
+  if ( (v = mixer_free_voice(PLAYER_VOICE + 1)) == MIXER_NONE ) return 0;
+
+  hold = level;
+  mixer_start(v, hold_source, &hold, MIXER_UNITY);
+  mixer_fade_out(v, PLAYER_FADE_LEN);
+
+  return 1;
+}
+
+/*! \brief  Mixer source of the main voice: the file and its queue
+ *
+ *  \param  ctx      not used
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples wanted
+ *
+ *  \details A file that preempts the playing one is opened when the fade-out
+ *           is complete.
+ *
+ *  \return number of samples made, less than n at the end of the last track
+ */
+static uint16_t main_source(void *ctx, uint16_t *dst, uint16_t n)
+{
+  const char *path = pending;
+  uint16_t    got;
+
+  (void) ctx;
+
+  if ( path && !mixer_ramping(PLAYER_VOICE) ) {   // old file has faded out
+    pending = 0;
+    close_main();
+    if (open_main(path) != FR_OK) {
+      stats.skipped++;
+      return 0;
+    }
+  }
+
+  got = produce(dst, n);
+  if (got < n && path) {                // ended during the fade-out
+    while (got < n) dst[got++] = tail;
+  } else if (got < n) {
+    close_main();
+  }
+
+  return got;
+}
+
+/*! \brief  Mixer source of an overlay voice: one file at the output rate
+ *
+ *  \param  ctx      track of the overlay
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples wanted
+ *
+ *  \return number of samples made, less than n at the end of the file
+ */
+static uint16_t overlay_source(void *ctx, uint16_t *dst, uint16_t n)
+{
+  track_t *t   = ctx;
+  uint16_t got = t->fill(t, dst, n);
+
+  if (got < n) {
+    f_close(&t->file);
+    overlay_voice[t - overlays] = 0;
+  }
+
+  return got;
+}
+
+/*! \brief  Read from the files until the ring is full or the last file ends
+ *
+ *  \details The voices are mixed into the ring. When all voices have ended
+ *           the output ramps to mid-scale and the last incomplete slot is
+ *           padded with copies of its last sample.
+ *           The gap at a track change is the number of underrun samples
+ *           between the change and the commit of the slot that holds it.
+ *
+ *  \return void
+ */
+static void refill(void)
+{
+  uint16_t *dst;
+  uint16_t  len, n, got, u;
+
+  while (state == PLAYER_PLAYING) {
+    dst = (uint16_t *) ring_reserve(&ring, &len);
+    if (len == 0) break;
+
+    n = len / sizeof(uint16_t);
+    if (n > PLAYER_READ_LEN) n = PLAYER_READ_LEN;
+#if AUDIO_PROFILE
+    if (resampling) n = SLOT_LEN;       // keep each measured run below 65535 cycles
+#endif
+
+    got = mixer_render(dst, n);
+    if (got) level = dst[got - 1];      // release() ramps from the last sample
+    if (got < n && release()) {
+      got += mixer_render(dst + got, n - got);
+      if (got) level = dst[got - 1];
+    }
+    if (got < n) {
+      state = PLAYER_DRAINING;
+      if (got == 0) break;
+      while (got & (SLOT_LEN - 1)) {
+        dst[got] = dst[got - 1];
+        got++;
+      }
+    }
+    ring_commit(&ring, got * sizeof(uint16_t));
+    LATENCY_MARK(LATENCY_BUFFER);
+
+    if (gap_open) {
+      ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        u = stats.underruns;
+      }
+      stats.gap = u - gap_mark;
+      if (stats.gap > stats.gap_max) stats.gap_max = stats.gap;
+      gap_open = 0;
+    }
+  }
+}
+
+/*! \brief  Start the main voice with a file
+ *
+ *  \param  path     name of the file on the mounted volume
+ *
+ *  \return FR_OK, FR_INVALID_PARAMETER for an unsupported format or the
+ *          FatFs error code
+ */
+static FRESULT open_main(const char *path)
+{
+  FRESULT res;
+
+  cur = &tracks[0];
+  tail = DAC_MID;
+  hc = headcache_find(path);
+  if (hc && out_rate && hc->rate != out_rate) hc = 0;
+  if (hc) {                             // no card access until the cached part is played
+    LATENCY_SKIP(LATENCY_OPEN);
+    LATENCY_SKIP(LATENCY_HEADER);
+    cur->info = hc->info;
+    track_empty(cur);
+    resampling = 0;
+    hc_ptr  = hc->data;
+    hc_left = hc->samples;
+    hc_open = 0;
+    out_rate = hc->rate;
+  } else {
+    if ( (res = track_open(cur, path)) != FR_OK ) {
+      return res;
+    }
+    if (out_rate == 0) {                // play at the rate of the first file
+      out_rate = cur->info.sample_rate;
+    }
+    set_rate();
+  }
+  stats.tracks++;
+  gap_open = 0;
+  main_open = 1;
+  released = 0;
+  mixer_start(PLAYER_VOICE, main_source, 0, main_gain);
+  mixer_fade_in(PLAYER_VOICE, PLAYER_FADE_LEN);
+
+  return FR_OK;
+}
+
+/*! \brief  Start the output from an empty ring
+ *
+ *  \return void
+ */
+static void start_output(void)
+{
+  if ( !ring.buf ) {
+    ring_init(&ring, ring_buf, PLAYER_RING_SLOTS, PLAYER_SLOT_SHIFT);
+  } else {
+    ring_flush(&ring);                  // blocks in the DMA are released later
+  }
+  last_sample = DAC_MID;
+  level = DAC_MID;
+
+  state = PLAYER_PLAYING;
+  refill();
+  ring_clear_watermarks(&ring);
+}
+
+/*! \brief  Start playing a file from an empty ring
+ *
+ *  \param  path     name of the file on the mounted volume
+ *
+ *  \return FR_OK, FR_INVALID_PARAMETER for an unsupported format or the
+ *          FatFs error code
+ */
+static FRESULT start(const char *path)
+{
+  FRESULT res = open_main(path);
+
+  if (res == FR_OK) start_output();
+
+  return res;
+}
+
+/*! \brief  Open a WAV file and fill the ring
+ *
+ *  \param  path     name of the file on the mounted volume
+ *
+ *  \details The file must contain PCM samples in a format supported by
+ *           pcm.h or IMA ADPCM with blocks of at most PLAYER_IN_LEN bytes,
+ *           at PLAYER_OUT_RATE or at a rate supported by the resampler. The
+ *           sample clock must be set to player_rate() and the output can be
+ *           started after this function returns FR_OK. The queue is cleared.
+ *
+ *           If the main voice is playing, it is preempted: it fades out
+ *           and the file starts with a fade-in. The file is opened at the
+ *           end of the fade-out; if that fails it is counted as skipped.
+ *
+ *  \return FR_OK, FR_INVALID_PARAMETER for an unsupported format or the
+ *          FatFs error code
+ */
+FRESULT player_open(const char *path)
+{
+  LATENCY_REQUEST();
+  q_head = q_tail = 0;
+  if ( state != PLAYER_IDLE && mixer_active(PLAYER_VOICE) && PLAYER_FADE_LEN ) {
+    pending = path;
+    mixer_ramp(PLAYER_VOICE, 0, PLAYER_FADE_LEN);
+    return FR_OK;
+  }
+  player_stop();
+
+  out_rate = PLAYER_OUT_RATE;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    stats.samples = 0;
+    stats.underruns = 0;
+  }
+  stats.blocks = stats.direct = 0;
+  stats.tracks = 0;
+  stats.skipped = 0;
+  stats.gap = stats.gap_max = 0;
+
+  return start(path);
+}
+
+/*! \brief  Put the start of a clip in the RAM cache
+ *
+ *  \param  path     name of the file on the mounted volume, must stay valid
+ *
+ *  \details Decodes the first HEADCACHE_CLIP_MS milliseconds (or what is
+ *           left of the pool) at the output rate. Call this function at
+ *           start-up, when no file is playing.
+ *
+ *  \return FR_OK, FR_DENIED while playing, FR_NOT_ENOUGH_CORE if the cache
+ *          is full, FR_INVALID_PARAMETER for an unsupported format or the
+ *          FatFs error code
+ */
+FRESULT player_cache(const char *path)
+{
+  headcache_entry_t *e;
+  uint16_t           got = 0, n, k;
+  FRESULT            res;
+
+  if (state != PLAYER_IDLE) return FR_DENIED;
+
+  cur = &tracks[0];
+  out_rate = PLAYER_OUT_RATE;
+  if ( (res = track_open(cur, path)) != FR_OK ) {
+    return res;
+  }
+  if (out_rate == 0) out_rate = cur->info.sample_rate;
+
+  e = headcache_alloc(path, (uint32_t) HEADCACHE_CLIP_MS * out_rate / 1000);
+  if ( !e ) {
+    f_close(&cur->file);
+    return FR_NOT_ENOUGH_CORE;
+  }
+
+  hc = 0;
+  hc_left = 0;
+  tail = DAC_MID;
+  set_rate();
+  while (got < e->samples) {
+    n = e->samples - got;
+#if AUDIO_PROFILE
+    if (n > SLOT_LEN) n = SLOT_LEN;     // keep each measured run below 65535 cycles
+#endif
+    k = produce(e->data + got, n);
+    got += k;
+    if (k < n) {
+      e->complete = 1;
+      break;
+    }
+  }
+  e->samples = got;
+  e->info    = cur->info;
+  e->rate    = out_rate;
+  f_close(&cur->file);
+
+  return FR_OK;
+}
+
+/*! \brief  Add a file to the queue
+ *
+ *  \param  path     name of the file on the mounted volume, must stay valid
+ *                   until the file is opened
+ *
+ *  \details The file is played directly after the previous one without a
+ *           gap. It is opened and its first block is read in advance,
+ *           while the previous file is still playing. If nothing is playing
+ *           this is the same as player_open(); if only other voices are
+ *           playing the file starts at once in the main voice. A file that
+ *           was queued after the last file was read completely starts after
+ *           a short gap.
+ *           With PLAYER_OUT_RATE 0 files at another rate than the first are
+ *           skipped.
+ *
+ *  \return FR_OK, FR_DENIED if the queue is full, or the result of
+ *          player_open()
+ */
+FRESULT player_queue(const char *path)
+{
+  FRESULT res;
+
+  if (state == PLAYER_IDLE) {
+    return player_open(path);
+  }
+  if ( !mixer_active(PLAYER_VOICE) ) {  // only other voices are playing
+    if ( (res = open_main(path)) == FR_OK ) state = PLAYER_PLAYING;
+    return res;
+  }
+  if ( (uint8_t) (q_head - q_tail) >= PLAYER_QUEUE_LEN ) {
+    return FR_DENIED;
+  }
+  queue[q_head++ & QUEUE_MASK] = path;
+
+  return FR_OK;
+}
+
+/*! \brief  Mix another source with the playback
+ *
+ *  \param  src      source of 12-bit DAC codes at player_rate()
+ *  \param  ctx      context passed to the source, must stay valid while
+ *                   the voice plays
+ *  \param  gain     Q15, MIXER_UNITY is 1.0
+ *
+ *  \details The source fades in from the next block that is mixed, without
+ *           stopping the other voices. If nothing is playing the output is
+ *           started; the rate must be known then (PLAYER_OUT_RATE or an
+ *           earlier player_open()).
+ *
+ *  \return the voice, MIXER_NONE if no voice is free
+ */
+uint8_t player_mix(mixer_source_t src, void *ctx, uint16_t gain)
+{
+  uint8_t v = mixer_free_voice(PLAYER_VOICE + 1);
+
+  if (v == MIXER_NONE || (state == PLAYER_IDLE && out_rate == 0)) {
+    return MIXER_NONE;
+  }
+  mixer_start(v, src, ctx, gain);
+  mixer_fade_in(v, PLAYER_FADE_LEN);
+  released = 0;
+
+  if (state == PLAYER_IDLE) {
+    start_output();
+  } else {
+    state = PLAYER_PLAYING;
+  }
+
+  return v;
+}
+
+/*! \brief  Play a clip from the sound bank in flash
+ *
+ *  \param  name     name of the clip, see flashbank.h
+ *  \param  gain     Q15, MIXER_UNITY is 1.0
+ *
+ *  \details The clip plays in a voice of its own, like player_mix(). It
+ *           needs no SD-card, so it also works when no volume is mounted.
+ *           The bank must be made at the output rate (PLAYER_OUT_RATE).
+ *
+ *  \return the voice, MIXER_NONE if the clip is not in the bank, the rate
+ *          differs or no voice is free
+ */
+uint8_t player_flash(const char *name, uint16_t gain)
+{
+  flashbank_clip_t *clip;
+  uint8_t           v = mixer_free_voice(PLAYER_VOICE + 1);
+
+  if (state == PLAYER_IDLE) out_rate = PLAYER_OUT_RATE;
+  if (out_rate == 0) out_rate = flashbank_rate();
+  if (v == MIXER_NONE || flashbank_rate() != out_rate) return MIXER_NONE;
+
+  clip = &flash_clips[v];
+  if ( !flashbank_open(clip, flashbank_find(name)) ) return MIXER_NONE;
+
+  return player_mix(flashbank_source, clip, gain);
+}
+
+/*! \brief  Start a file or a clip of the sound bank in another voice
+ *
+ *  \param  path     name of the file on the mounted volume, 0 for a clip
+ *  \param  id       number of the clip in the sound bank
+ *  \param  gain     Q15, MIXER_UNITY is 1.0
+ *  \param  voice    pointer to store the voice
+ *
+ *  \return see player_overlay()
+ */
+static FRESULT overlay_start(const char *path, uint16_t id, uint16_t gain, uint8_t *voice)
+{
+  track_t *t = 0;
+  FRESULT  res;
+  uint8_t  i;
+
+  for (i = 0; i < PLAYER_OVERLAYS; i++) {
+    if ( !overlay_voice[i] ) t = &overlays[i];
+  }
+  if ( !t || mixer_free_voice(PLAYER_VOICE + 1) == MIXER_NONE ) {
+    return FR_TOO_MANY_OPEN_FILES;
+  }
+
+  if (state == PLAYER_IDLE) out_rate = PLAYER_OUT_RATE;
+  res = path ? track_open(t, path) : track_open_clip(t, id);
+  if (res != FR_OK) {
+    return res;
+  }
+  if (out_rate == 0) out_rate = t->info.sample_rate;
+  if (t->info.sample_rate != out_rate) {
+    f_close(&t->file);
+    return FR_INVALID_PARAMETER;
+  }
+
+  *voice = player_mix(overlay_source, t, gain);
+  overlay_voice[t - overlays] = *voice;
+
+  return FR_OK;
+}
+
+/*! \brief  Play a file in another voice, over the playback
+ *
+ *  \param  path     name of the file on the mounted volume
+ *  \param  gain     Q15, MIXER_UNITY is 1.0
+ *  \param  voice    pointer to store the voice
+ *
+ *  \details The file must be PCM or IMA ADPCM at player_rate(); it is not
+ *           resampled. At most PLAYER_OVERLAYS files play in other voices.
+ *
+ *  \return FR_OK, FR_TOO_MANY_OPEN_FILES if no overlay or voice is free,
+ *          FR_INVALID_PARAMETER for an unsupported format or the FatFs
+ *          error code
+ */
+FRESULT player_overlay(const char *path, uint16_t gain, uint8_t *voice)
+{
+  return overlay_start(path, 0, gain, voice);
+}
+
+/*! \brief  Play a clip of the sound bank in another voice
+ *
+ *  \param  id       number of the clip in the bank of soundbank_mount()
+ *  \param  gain     Q15, MIXER_UNITY is 1.0
+ *  \param  voice    pointer to store the voice
+ *
+ *  \details Like player_overlay(), but the clip starts without a directory
+ *           lookup or a header read: its first sector is read directly.
+ *
+ *  \return FR_OK, FR_TOO_MANY_OPEN_FILES if no overlay or voice is free,
+ *          FR_INVALID_PARAMETER for an unsupported format, FR_NO_FILE if
+ *          the clip is not in the bank or FR_NOT_ENABLED if no bank is
+ *          mounted
+ */
+FRESULT player_clip(uint16_t id, uint16_t gain, uint8_t *voice)
+{
+  return overlay_start(0, id, gain, voice);
+}
+
+/*! \brief  Change the volume of a voice with a short ramp
+ *
+ *  \param  voice    PLAYER_VOICE, a voice of player_overlay() or of
+ *                   player_mix()
+ *  \param  db       level, 0 is unity, GAIN_DB_MIN and lower is muted
+ *
+ *  \details The volume of PLAYER_VOICE is kept for the next files.
+ *
+ *  \return void
+ */
+void player_volume(uint8_t voice, int8_t db)
+{
+  uint16_t gain = gain_db(db);
+
+  if (voice == PLAYER_VOICE) main_gain = gain;
+  if (voice != PLAYER_VOICE || !pending) mixer_set_gain(voice, gain);
+}
+
+/*! \brief  Fade out one voice and stop it
+ *
+ *  \param  voice    PLAYER_VOICE (also clears the queue), a voice of
+ *                   player_overlay() or of player_mix()
+ *
+ *  \details The other voices go on. The files of the voice are closed by
+ *           player_service() after the fade-out.
+ *
+ *  \return void
+ */
+void player_stop_voice(uint8_t voice)
+{
+  if (voice == PLAYER_VOICE) {
+    q_head = q_tail = 0;
+    pending = 0;
+  }
+  mixer_fade_out(voice, PLAYER_FADE_LEN);
+}
+
+/*! \brief  Fade out all voices and clear the queue
+ *
+ *  \details The output ramps to mid-scale and player_service() returns 0
+ *           when the ring is empty.
+ *
+ *  \return void
+ */
+void player_fade_out(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < MIXER_VOICES; i++) {
+    player_stop_voice(i);
+  }
+}
+
+/*! \brief  Close the files of voices that have been stopped
+ *
+ *  \return void
+ */
+static void reap(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < PLAYER_OVERLAYS; i++) {
+    if ( overlay_voice[i] && !mixer_active(overlay_voice[i]) ) {
+      f_close(&overlays[i].file);
+      overlay_voice[i] = 0;
+    }
+  }
+  if ( main_open && !mixer_active(PLAYER_VOICE) ) close_main();
+}
+
+/*! \brief  Stop playback of all voices at once, close the files and clear
+ *          the queue
+ *
+ *  \details The output jumps to the level of the next samples; use
+ *           player_fade_out() to stop without a click.
+ *
+ *  \return void
+ */
+void player_stop(void)
+{
+  q_head = q_tail = 0;
+  pending = 0;
+  if (state == PLAYER_IDLE) return;
+
+  mixer_stop_all();
+  reap();
+  state = PLAYER_IDLE;
+  ring_flush(&ring);
+  level = DAC_MID;
+}
+
+/*! \brief  Refill the ring. Call this function from the main loop.
+ *
+ *  \details When the ring is full and less than PLAYER_PREFETCH bytes of
+ *           the current file are left, the next file of the queue is opened.
+ *
+ *  \return 1 while a voice is still playing, 0 when playback has finished
+ */
+uint8_t player_service(void)
+{
+  refill();
+  reap();
+
+  if ( mixer_active(PLAYER_VOICE) ) {
+    if (hc && hc_open == 0) {
+      catch_up();                       // open the cached clip while its start plays
+    }
+    if ( (!hc || hc_open) && cur->data_left <= PLAYER_PREFETCH ) {
+      prefetch();
+    }
+  } else if (state == PLAYER_PLAYING) {
+    while (q_tail != q_head && !mixer_active(PLAYER_VOICE)) {  // other voices still play
+      if ( open_main(queue[q_tail++ & QUEUE_MASK]) != FR_OK ) stats.skipped++;
+    }
+  }
+
+  if (state == PLAYER_DRAINING && ring_used(&ring) == 0) {
+    state = PLAYER_IDLE;
+    while (q_tail != q_head && state == PLAYER_IDLE) {   // queued too late for a gapless start
+      if ( start(queue[q_tail++ & QUEUE_MASK]) != FR_OK ) stats.skipped++;
+    }
+  }
+
+  return state != PLAYER_IDLE;
+}
+
+/*! \brief  Get the format of the file being played
+ *
+ *  \return pointer to the format, valid after player_open() returned FR_OK
+ */
+const wav_info_t *player_info(void)
+{
+  return &cur->info;
+}
+
+/*! \brief  Get the output sample rate
+ *
+ *  \return PLAYER_OUT_RATE, or the rate of the first file if PLAYER_OUT_RATE is 0
+ */
+uint16_t player_rate(void)
+{
+  return out_rate;
+}
+
+/*! \brief  Test if a file is playing
+ *
+ *  \return 1 if a file is open, 0 otherwise
+ */
+uint8_t player_busy(void)
+{
+  return state != PLAYER_IDLE;
+}
+
+/*! \brief  Get the next sample. Call this function from the sample interrupt.
+ *
+ *  \details If the ring is empty the previous sample is repeated. During
+ *           playback this is counted as an underrun.
+ *
+ *  \return 12-bit DAC code
+ */
+uint16_t player_next_sample(void)
+{
+  const uint8_t *p = ring_read_ptr(&ring);
+
+  if ( !p ) {
+    if (state == PLAYER_PLAYING) stats.underruns++;
+    return last_sample;
+  }
+
+  last_sample = *(const uint16_t *) p;
+  ring_read_advance(&ring, sizeof(uint16_t));
+  if (stats.samples++ == 0) {
+    LATENCY_MARK(LATENCY_DAC);          // written to the DAC on return
+  }
+
+  return last_sample;
+}
+
+/*! \brief  Claim the next slot for a block transfer. Call this function
+ *          from the block interrupt of the output driver.
+ *
+ *  \param  len      pointer to store the number of samples in the block
+ *
+ *  \details The slot stays owned by the output driver until it is given
+ *           back with player_release_block(). At most two blocks can be
+ *           claimed at the same time. If the ring is empty a block of
+ *           PLAYER_SILENCE_LEN copies of the previous sample is returned.
+ *
+ *  \return pointer to the 12-bit DAC codes of the block
+ */
+const uint16_t *player_claim_block(uint16_t *len)
+{
+  const uint16_t *p = (const uint16_t *) ring_claim(&ring);
+  uint16_t        i;
+
+  if ( !p ) {
+    // silence[] is not in use: the other claimed block is a slot or
+    // a silence block with the same value
+    for (i = 0; i < PLAYER_SILENCE_LEN; i++) {
+      silence[i] = last_sample;
+    }
+    if (state == PLAYER_PLAYING) stats.underruns += PLAYER_SILENCE_LEN;
+    claimed |= 1 << claim_in;
+    claim_in ^= 1;
+    *len = PLAYER_SILENCE_LEN;
+    return silence;
+  }
+
+  claimed &= ~(1 << claim_in);
+  claim_in ^= 1;
+  last_sample = p[SLOT_LEN - 1];
+  if (stats.samples == 0) {
+    LATENCY_MARK(LATENCY_DAC);          // queued to the DAC on return
+  }
+  stats.samples += SLOT_LEN;
+  *len = SLOT_LEN;
+
+  return p;
+}
+
+/*! \brief  Give back the oldest block claimed with player_claim_block()
+ *
+ *  \return void
+ */
+void player_release_block(void)
+{
+  uint8_t silent = claimed & (1 << claim_out);
+
+  claim_out ^= 1;
+  if ( !silent ) ring_release(&ring);   // hand back to the main loop
+}
+
+/*! \brief  Get the cycles spent reading the files
+ *
+ *  \param  load     pointer to store the measurement, one run per block
+ *  \param  bytes    pointer to store the number of bytes read
+ *
+ *  \details The read throughput is *bytes / load->total bytes per cycle;
+ *           build with PLAYER_EXTENTS 0 to get the same for f_read() only.
+ *           The cycles include waiting for the card and the interrupts
+ *           during the reads. Only measured when AUDIO_PROFILE is 1; a run
+ *           longer than 65535 cycles is counted in full in the total and
+ *           as 65535 in the maximum.
+ *
+ *  \return void
+ */
+void player_get_read_load(cycles_t *load, uint32_t *bytes)
+{
+#if AUDIO_PROFILE
+  *load = read_load;
+#else
+  memset(load, 0, sizeof(*load));
+#endif
+  *bytes = read_bytes;
+}
+
+/*! \brief  Get a copy of the playback statistics
+ *
+ *  \param  st       pointer to store the statistics
+ *
+ *  \return void
+ */
+void player_get_stats(player_stats_t *st)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    *st = stats;
+  }
+  st->ring_low  = (uint16_t) ring.low  * SLOT_LEN;
+  st->ring_high = (uint16_t) ring.high * SLOT_LEN;
+}
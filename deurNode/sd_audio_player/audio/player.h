@@ -0,0 +1,129 @@
+/*!
+ *  \file    player.h
+ *  \brief   Buffered WAV playback engine for the door node
+ *
+ *  \details The engine keeps a ring of PLAYER_RING_SLOTS slots of 12-bit DAC
+ *           codes. The sample interrupt only consumes samples with
+ *           player_next_sample(), the main loop refills free slots from
+ *           FatFs with player_service(). With DMA output whole slots are
+ *           claimed by the block interrupt instead (player_claim_block()).
+ *           The file is decoded to DAC codes by the kernel for its format
+ *           (pcm.h) or by the IMA ADPCM decoder (adpcm.h). Files at another
+ *           rate than PLAYER_OUT_RATE are converted by the polyphase
+ *           resampler (resample.h).
+ *           Files added with player_queue() follow without a gap: the next
+ *           file is opened and its first block is read while the tail of the
+ *           current file is playing.
+ *           Clips put in the RAM cache with player_cache() start without
+ *           waiting for the SD-card (headcache.h). Files in the clip index
+ *           (clipindex.h) are opened without reading the directory or the
+ *           header.
+ *           At open time the cluster chain of a file is turned into at most
+ *           PLAYER_EXTENTS extents (first sector, number of sectors). The
+ *           data is then read with disk_read() along the extents, whole
+ *           sectors at a time and up to PLAYER_IN_LEN bytes per call, without
+ *           the per call work of f_read(). Files with more fragments, and
+ *           ADPCM files whose blocks are not whole sectors, are read with
+ *           f_read(). Build with PLAYER_EXTENTS 0 to compare both with
+ *           player_get_read_load().
+ *           The main file stream is voice PLAYER_VOICE of the mixer
+ *           (mixer.h); other files and sources can be mixed over it with
+ *           player_overlay() and player_mix(). Clips in the flash sound
+ *           bank (flashbank.h) play with player_flash(), also without an
+ *           SD-card; clips in the sound bank on the card (soundbank.h) with
+ *           player_clip().
+ *           Voices fade in when they start and fade out when they are
+ *           stopped with player_stop_voice() or preempted by player_open().
+ *           When the last voice ends, the output ramps from the last sample
+ *           to mid-scale, so the DAC can be stopped without a click.
+ *           No SD-card access is done at interrupt level.
+ */
+#ifndef PLAYER_H_
+#define PLAYER_H_
+
+#include <stdint.h>
+#include "../ff/ff.h"
+#include "wav.h"
+#include "resample.h"
+#include "mixer.h"
+#include "cycles.h"
+
+#ifndef PLAYER_RING_SLOTS
+#define PLAYER_RING_SLOTS   16  //!< number of ring slots (power of two, 2..128)
+#endif
+#ifndef PLAYER_SLOT_SHIFT
+#define PLAYER_SLOT_SHIFT   7   //!< log2 of the slot size in bytes (128 bytes = 64 samples)
+#endif
+#ifndef PLAYER_READ_LEN
+#define PLAYER_READ_LEN     256 //!< maximum number of samples decoded per ring reserve
+#endif
+#ifndef PLAYER_IN_LEN
+#define PLAYER_IN_LEN       512 //!< bytes per read (multiple of 512 for extents), largest ADPCM block
+#endif
+#ifndef PLAYER_EXTENTS
+#define PLAYER_EXTENTS      4   //!< fragments of a file read past FatFs, 0: always f_read()
+#endif
+
+#ifndef PLAYER_OUT_RATE
+#define PLAYER_OUT_RATE     RESAMPLE_OUT_RATE   //!< DAC rate, 0: rate of the file (no resampling)
+#endif
+
+#ifndef PLAYER_QUEUE_LEN
+#define PLAYER_QUEUE_LEN    4   //!< files in the queue (power of two, 2..128)
+#endif
+#ifndef PLAYER_PREFETCH
+#define PLAYER_PREFETCH     4096    //!< bytes left in the current file when the next is opened
+#endif
+
+#ifndef PLAYER_OVERLAYS
+#define PLAYER_OVERLAYS     1   //!< files that can play in other voices at the same time
+#endif
+
+#define PLAYER_VOICE        0   //!< mixer voice of the main file stream
+
+#ifndef PLAYER_FADE_LEN
+#define PLAYER_FADE_LEN     256 //!< samples of a fade-in, fade-out or ramp to mid-scale, 0: none
+#endif
+
+#ifndef PLAYER_SILENCE_LEN
+#define PLAYER_SILENCE_LEN  32  //!< samples in a block output on an underrun
+#endif
+
+#define DAC_MID         2048    //!< DAC code for the mid-scale (silence) level
+
+/*! \brief  Playback statistics */
+typedef struct {
+  uint32_t samples;             //!< samples delivered to the DAC
+  uint16_t underruns;           //!< samples requested while no buffer was ready
+  uint16_t blocks;              //!< blocks of PLAYER_IN_LEN bytes read from the file
+  uint16_t direct;              //!< blocks of those read with disk_read() along the extents
+  uint16_t ring_low;            //!< fewest samples in the ring during playback
+  uint16_t ring_high;           //!< most samples in the ring during playback
+  uint16_t tracks;              //!< files started
+  uint16_t skipped;             //!< queued files that could not be played
+  uint16_t gap;                 //!< underrun samples at the last track change
+  uint16_t gap_max;             //!< largest gap at a track change
+} player_stats_t;
+
+FRESULT  player_open(const char *path);
+FRESULT  player_queue(const char *path);
+FRESULT  player_cache(const char *path);
+uint8_t  player_mix(mixer_source_t src, void *ctx, uint16_t gain);
+FRESULT  player_overlay(const char *path, uint16_t gain, uint8_t *voice);
+uint8_t  player_flash(const char *name, uint16_t gain);
+FRESULT  player_clip(uint16_t id, uint16_t gain, uint8_t *voice);
+void     player_volume(uint8_t voice, int8_t db);
+void     player_stop_voice(uint8_t voice);
+void     player_fade_out(void);
+void     player_stop(void);
+uint8_t  player_service(void);
+uint8_t  player_busy(void);
+const wav_info_t *player_info(void);
+uint16_t player_rate(void);
+uint16_t player_next_sample(void);
+const uint16_t *player_claim_block(uint16_t *len);
+void     player_release_block(void);
+void     player_get_stats(player_stats_t *st);
+void     player_get_read_load(cycles_t *load, uint32_t *bytes);
+
+#endif // PLAYER_H_
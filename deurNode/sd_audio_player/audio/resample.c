@@ -0,0 +1,252 @@
+/*!
+ *  \file    resample.c
+ *  \brief   Fixed-point polyphase sample-rate converter
+ *
+ *  \details Output sample k lies between input x[pos + taps/2 - 1] and
+ *           x[pos + taps/2], at the fraction frac / RESAMPLE_OUT_RATE. It is
+ *           the sum of x[pos] .. x[pos + taps - 1] times the taps of the
+ *           nearest phase. A fraction closer to the next input than to the
+ *           last phase uses phase 0 one input further. The taps of every phase sum to 1.0 (Q15), so the
+ *           12-bit DAC codes can be filtered directly: mid-scale stays
+ *           mid-scale and no offset has to be removed.
+ *
+ *           Per output the inner loop does taps 16x16 bit multiply-adds with
+ *           the coefficient read from flash. The cost per output sample can
+ *           be read with resample_get_load() when AUDIO_PROFILE is 1.
+ */
+#include "resample.h"
+#include "resample_coef.h"
+
+#include <string.h>
+#include <avr/pgmspace.h>
+
+#if RESAMPLE_COEF_RATE != RESAMPLE_OUT_RATE
+#error "resample_coef.h is made for another output rate, run tools/gen_resample_coef"
+#endif
+
+#define PHASE_MUL  ((((uint32_t) RESAMPLE_PHASES << 17) / RESAMPLE_OUT_RATE + 1) >> 1)   //!< fraction to phase, rounded
+
+static cycles_t rs_load;                //!< cycles in resample_run()
+static uint32_t rs_outputs;             //!< output samples made
+
+/*! \brief  Find the filter table for an input rate
+ *
+ *  \param  rate     input rate in Hz
+ *
+ *  \return pointer to the table, 0 if there is none
+ */
+static const resample_table_t *find_table(uint32_t rate)
+{
+  uint8_t i;
+
+  for (i = 0; i < sizeof(resample_tables) / sizeof(resample_tables[0]); i++) {
+    if (resample_tables[i].rate == rate) return &resample_tables[i];
+  }
+
+  return 0;
+}
+
+/*! \brief  Test if an input rate can be converted
+ *
+ *  \param  rate     input rate in Hz
+ *
+ *  \return 1 if there is a filter table for the rate, 0 otherwise
+ */
+uint8_t resample_supported(uint32_t rate)
+{
+  return find_table(rate) != 0;
+}
+
+/*! \brief  Initialize a converter for an input rate
+ *
+ *  \param  rs       converter
+ *  \param  rate     input rate in Hz
+ *  \param  fill     DAC code of the (silent) history before the first sample
+ *
+ *  \return 1 on success, 0 if there is no filter table for the rate
+ */
+uint8_t resample_init(resample_t *rs, uint32_t rate, uint16_t fill)
+{
+  const resample_table_t *tab = find_table(rate);
+
+  if ( !tab ) return 0;
+
+  rs->coef     = tab->coef;
+  rs->taps     = tab->taps;
+  rs->step_int = rate / RESAMPLE_OUT_RATE;
+  rs->step_rem = rate % RESAMPLE_OUT_RATE;
+  rs->frac     = 0;
+  rs->pos      = 0;
+
+  // history so that the first output is at the first input sample
+  for (rs->nx = 0; rs->nx < rs->taps / 2 - 1; rs->nx++) {
+    rs->x[rs->nx] = fill;
+  }
+
+  return 1;
+}
+
+/*! \brief  Initialize a converter to continue at an output sample
+ *
+ *  \param  rs       converter
+ *  \param  rate     input rate in Hz
+ *  \param  out      index of the next output sample
+ *  \param  fill     DAC code of the history before the first sample, as
+ *                   given to resample_init() for the start of the stream
+ *
+ *  \details Makes the same state as resample_init() followed by out output
+ *           samples, without the input before the filter history. The input
+ *           must be given from the returned input index on. Keep
+ *           out * rate below 2^32.
+ *
+ *  \return index of the first input sample to write, 0xFFFFFFFF if there is
+ *          no filter table for the rate
+ */
+uint32_t resample_start_at(resample_t *rs, uint32_t rate, uint32_t out, uint16_t fill)
+{
+  uint32_t p, h;
+
+  if ( !resample_init(rs, rate, fill) ) return 0xFFFFFFFF;
+
+  p        = out * rate / RESAMPLE_OUT_RATE;    // first tap of output out, in x[] of the start
+  rs->frac = out * rate % RESAMPLE_OUT_RATE;
+  h        = rs->nx;                            // history samples at the start
+  if (p < h) {
+    rs->nx = h - p;
+    return 0;
+  }
+  rs->nx = 0;
+
+  return p - h;
+}
+
+/*! \brief  Get the memory for new input samples
+ *
+ *  \param  rs       converter
+ *  \param  room     pointer to store the number of samples that fit
+ *
+ *  \return pointer to write the new input samples
+ */
+uint16_t *resample_in_ptr(resample_t *rs, uint16_t *room)
+{
+  *room = sizeof(rs->x) / sizeof(rs->x[0]) - rs->nx;
+
+  return rs->x + rs->nx;
+}
+
+/*! \brief  Publish new input samples
+ *
+ *  \param  rs       converter
+ *  \param  n        number of samples written at resample_in_ptr()
+ *
+ *  \return void
+ */
+void resample_in_commit(resample_t *rs, uint16_t n)
+{
+  rs->nx += n;
+}
+
+/*! \brief  Append half a filter length of the last input sample, so the
+ *          last real input samples can be output
+ *
+ *  \param  rs       converter
+ *
+ *  \details Does nothing when no input is buffered: every output centred
+ *           on a real input sample has been made already.
+ *
+ *  \return void
+ */
+void resample_flush(resample_t *rs)
+{
+  uint16_t last;
+  uint8_t  i;
+
+  if (rs->nx == 0) return;
+
+  last = rs->x[rs->nx - 1];
+  for (i = 0; i < rs->taps / 2; i++) {
+    if (rs->nx >= sizeof(rs->x) / sizeof(rs->x[0])) break;
+    rs->x[rs->nx++] = last;
+  }
+}
+
+/*! \brief  Make output samples from the buffered input
+ *
+ *  \param  rs       converter
+ *  \param  out      pointer to store the 12-bit DAC codes
+ *  \param  n        maximum number of output samples
+ *
+ *  \details Used input is removed from the buffer. Keep n small enough
+ *           (64 or less) for a valid cycle measurement.
+ *
+ *  \return number of output samples, less than n if more input is needed
+ */
+uint16_t resample_run(resample_t *rs, uint16_t *out, uint16_t n)
+{
+  const int16_t  *c;
+  const uint16_t *xp;
+  int32_t         acc;
+  uint16_t        k = 0;
+  uint8_t         t, phase;
+
+  CYCLES_BEGIN(t0);
+
+  while (k < n && rs->pos + rs->taps <= rs->nx) {
+    phase = ((uint32_t) rs->frac * PHASE_MUL + 0x8000) >> 16;     // nearest phase
+    xp    = rs->x + rs->pos;
+    if (phase == RESAMPLE_PHASES) {     // nearest is phase 0 of the next input
+      if (rs->pos + rs->taps >= rs->nx) break;
+      phase = 0;
+      xp++;
+    }
+    c     = rs->coef + phase * rs->taps;
+
+    acc = 1L << 14;                     // rounding
+    for (t = 0; t < rs->taps; t++) {
+      acc += (int32_t) (int16_t) pgm_read_word(c + t) * (int32_t) xp[t];
+    }
+    acc >>= 15;
+    if (acc < 0)    acc = 0;
+    if (acc > 4095) acc = 4095;
+    out[k++] = acc;
+
+    rs->pos  += rs->step_int;
+    rs->frac += rs->step_rem;
+    if (rs->frac >= RESAMPLE_OUT_RATE) {
+      rs->frac -= RESAMPLE_OUT_RATE;
+      rs->pos++;
+    }
+  }
+
+  if (rs->pos) {                        // keep the history for the next block
+    if (rs->pos < rs->nx) {
+      memmove(rs->x, rs->x + rs->pos, (rs->nx - rs->pos) * sizeof(rs->x[0]));
+      rs->nx -= rs->pos;
+    } else {
+      rs->nx = 0;
+    }
+    rs->pos = 0;
+  }
+
+  rs_outputs += k;
+  CYCLES_END(rs_load, t0);
+
+  return k;
+}
+
+/*! \brief  Get the cycles spent in resample_run()
+ *
+ *  \param  load     pointer to store the measurement
+ *  \param  outputs  pointer to store the number of output samples made
+ *
+ *  \details The cycles per output sample are load->total / *outputs. Only
+ *           measured when AUDIO_PROFILE is 1. Interrupts during
+ *           resample_run() are included.
+ *
+ *  \return void
+ */
+void resample_get_load(cycles_t *load, uint32_t *outputs)
+{
+  cycles_get(&rs_load, load);
+  *outputs = rs_outputs;
+}
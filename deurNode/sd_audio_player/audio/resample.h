@@ -0,0 +1,69 @@
+/*!
+ *  \file    resample.h
+ *  \brief   Fixed-point polyphase sample-rate converter
+ *
+ *  \details Converts a stream of 12-bit DAC codes from one of the supported
+ *           input rates (8000, 11025, 22050 and 44100 Hz) to the output rate
+ *           RESAMPLE_OUT_RATE. The filter tables are Q15 and live in flash
+ *           (resample_coef.h, made by tools/gen_resample_coef.c).
+ *
+ *           The position in the input is kept as a whole sample index plus
+ *           an exact fraction in units of 1/RESAMPLE_OUT_RATE, so the ratio
+ *           is exact and the output does not drift. The fraction selects the
+ *           nearest of RESAMPLE_PHASES filter phases.
+ *
+ *           Usage in blocks:
+ *           - write new input samples at resample_in_ptr() and publish them
+ *             with resample_in_commit();
+ *           - take output with resample_run() until it returns less than
+ *             asked, then write new input again;
+ *           - at the end of the input call resample_flush() once, so the
+ *             last input samples also reach the output.
+ *           .
+ *           With AUDIO_PROFILE set to 1 the cycles in resample_run() are
+ *           measured, see resample_get_load().
+ */
+#ifndef RESAMPLE_H_
+#define RESAMPLE_H_
+
+#include <stdint.h>
+#include "cycles.h"
+
+#ifndef RESAMPLE_OUT_RATE
+#define RESAMPLE_OUT_RATE   16000       //!< output rate, must match resample_coef.h
+#endif
+#define RESAMPLE_PHASES     32          //!< filter phases per input sample
+#define RESAMPLE_TAPS_MAX   24          //!< longest filter (44100 Hz input)
+#ifndef RESAMPLE_IN_LEN
+#define RESAMPLE_IN_LEN     256         //!< input samples buffered per block
+#endif
+
+/*! \brief  Filter table for one input rate */
+typedef struct {
+  uint16_t       rate;                  //!< input rate in Hz
+  uint8_t        taps;                  //!< taps per phase
+  const int16_t *coef;                  //!< [RESAMPLE_PHASES][taps] in flash
+} resample_table_t;
+
+/*! \brief  Converter state */
+typedef struct {
+  const int16_t *coef;                  //!< filter table in flash
+  uint8_t        taps;                  //!< taps per phase
+  uint8_t        step_int;              //!< whole input samples per output
+  uint16_t       step_rem;              //!< fraction per output, in 1/RESAMPLE_OUT_RATE
+  uint16_t       frac;                  //!< current fraction, in 1/RESAMPLE_OUT_RATE
+  uint16_t       pos;                   //!< index of the first tap in x[]
+  uint16_t       nx;                    //!< valid samples in x[]
+  uint16_t       x[RESAMPLE_TAPS_MAX - 1 + RESAMPLE_IN_LEN];   //!< input history and block
+} resample_t;
+
+uint8_t   resample_supported(uint32_t rate);
+uint8_t   resample_init(resample_t *rs, uint32_t rate, uint16_t fill);
+uint32_t  resample_start_at(resample_t *rs, uint32_t rate, uint32_t out, uint16_t fill);
+uint16_t *resample_in_ptr(resample_t *rs, uint16_t *room);
+void      resample_in_commit(resample_t *rs, uint16_t n);
+void      resample_flush(resample_t *rs);
+uint16_t  resample_run(resample_t *rs, uint16_t *out, uint16_t n);
+void      resample_get_load(cycles_t *load, uint32_t *outputs);
+
+#endif // RESAMPLE_H_
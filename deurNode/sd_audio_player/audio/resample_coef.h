@@ -0,0 +1,161 @@
+/*!
+ *  \file    resample_coef.h
+ *  \brief   Polyphase filter tables for an output rate of 16000 Hz
+ *
+ *  \details Generated by tools/gen_resample_coef.c, do not edit.
+ */
+#ifndef RESAMPLE_COEF_H_
+#define RESAMPLE_COEF_H_
+
+#include <avr/pgmspace.h>
+
+#define RESAMPLE_COEF_RATE  16000     //!< output rate of these tables
+
+static const int16_t resample_coef_8000[32][8] PROGMEM = {
+  {   187, -1042,  2493, 29492,  2493, -1042,   187,     0 },
+  {   160,  -865,  1723, 29446,  3315, -1226,   215,     0 },
+  {   135,  -697,  1006, 29310,  4187, -1416,   244,    -1 },
+  {   112,  -538,   344, 29082,  5105, -1610,   274,    -1 },
+  {    91,  -390,  -263, 28767,  6067, -1806,   304,    -2 },
+  {    72,  -252,  -813, 28364,  7069, -2003,   335,    -4 },
+  {    55,  -126, -1307, 27876,  8107, -2197,   365,    -5 },
+  {    39,   -12, -1746, 27312,  9176, -2388,   394,    -7 },
+  {    26,    90, -2130, 26668, 10272, -2571,   422,    -9 },
+  {    15,   181, -2461, 25951, 11390, -2744,   447,   -11 },
+  {     5,   260, -2739, 25166, 12524, -2905,   470,   -13 },
+  {    -2,   327, -2967, 24318, 13668, -3051,   490,   -15 },
+  {    -9,   383, -3147, 23414, 14817, -3178,   505,   -17 },
+  {   -13,   429, -3281, 22455, 15964, -3283,   515,   -18 },
+  {   -17,   464, -3372, 21454, 17103, -3363,   519,   -20 },
+  {   -19,   490, -3423, 20410, 18228, -3415,   517,   -20 },
+  {   -20,   508, -3436, 19331, 19333, -3436,   508,   -20 },
+  {   -20,   517, -3415, 18228, 20410, -3423,   490,   -19 },
+  {   -20,   519, -3363, 17103, 21454, -3372,   464,   -17 },
+  {   -18,   515, -3283, 15964, 22455, -3281,   429,   -13 },
+  {   -17,   505, -3178, 14817, 23414, -3147,   383,    -9 },
+  {   -15,   490, -3051, 13668, 24318, -2967,   327,    -2 },
+  {   -13,   470, -2905, 12524, 25166, -2739,   260,     5 },
+  {   -11,   447, -2744, 11390, 25951, -2461,   181,    15 },
+  {    -9,   422, -2571, 10272, 26668, -2130,    90,    26 },
+  {    -7,   394, -2388,  9176, 27312, -1746,   -12,    39 },
+  {    -5,   365, -2197,  8107, 27876, -1307,  -126,    55 },
+  {    -4,   335, -2003,  7069, 28364,  -813,  -252,    72 },
+  {    -2,   304, -1806,  6067, 28767,  -263,  -390,    91 },
+  {    -1,   274, -1610,  5105, 29082,   344,  -538,   112 },
+  {    -1,   244, -1416,  4187, 29310,  1006,  -697,   135 },
+  {     0,   215, -1226,  3315, 29446,  1723,  -865,   160 }
+};
+
+static const int16_t resample_coef_11025[32][8] PROGMEM = {
+  {   187, -1042,  2493, 29492,  2493, -1042,   187,     0 },
+  {   160,  -865,  1723, 29446,  3315, -1226,   215,     0 },
+  {   135,  -697,  1006, 29310,  4187, -1416,   244,    -1 },
+  {   112,  -538,   344, 29082,  5105, -1610,   274,    -1 },
+  {    91,  -390,  -263, 28767,  6067, -1806,   304,    -2 },
+  {    72,  -252,  -813, 28364,  7069, -2003,   335,    -4 },
+  {    55,  -126, -1307, 27876,  8107, -2197,   365,    -5 },
+  {    39,   -12, -1746, 27312,  9176, -2388,   394,    -7 },
+  {    26,    90, -2130, 26668, 10272, -2571,   422,    -9 },
+  {    15,   181, -2461, 25951, 11390, -2744,   447,   -11 },
+  {     5,   260, -2739, 25166, 12524, -2905,   470,   -13 },
+  {    -2,   327, -2967, 24318, 13668, -3051,   490,   -15 },
+  {    -9,   383, -3147, 23414, 14817, -3178,   505,   -17 },
+  {   -13,   429, -3281, 22455, 15964, -3283,   515,   -18 },
+  {   -17,   464, -3372, 21454, 17103, -3363,   519,   -20 },
+  {   -19,   490, -3423, 20410, 18228, -3415,   517,   -20 },
+  {   -20,   508, -3436, 19331, 19333, -3436,   508,   -20 },
+  {   -20,   517, -3415, 18228, 20410, -3423,   490,   -19 },
+  {   -20,   519, -3363, 17103, 21454, -3372,   464,   -17 },
+  {   -18,   515, -3283, 15964, 22455, -3281,   429,   -13 },
+  {   -17,   505, -3178, 14817, 23414, -3147,   383,    -9 },
+  {   -15,   490, -3051, 13668, 24318, -2967,   327,    -2 },
+  {   -13,   470, -2905, 12524, 25166, -2739,   260,     5 },
+  {   -11,   447, -2744, 11390, 25951, -2461,   181,    15 },
+  {    -9,   422, -2571, 10272, 26668, -2130,    90,    26 },
+  {    -7,   394, -2388,  9176, 27312, -1746,   -12,    39 },
+  {    -5,   365, -2197,  8107, 27876, -1307,  -126,    55 },
+  {    -4,   335, -2003,  7069, 28364,  -813,  -252,    72 },
+  {    -2,   304, -1806,  6067, 28767,  -263,  -390,    91 },
+  {    -1,   274, -1610,  5105, 29082,   344,  -538,   112 },
+  {    -1,   244, -1416,  4187, 29310,  1006,  -697,   135 },
+  {     0,   215, -1226,  3315, 29446,  1723,  -865,   160 }
+};
+
+static const int16_t resample_coef_22050[32][12] PROGMEM = {
+  {   -42,   318,  -151, -2694,  8256, 21394,  8256, -2694,  -151,   318,   -42,     0 },
+  {   -41,   296,   -73, -2725,  7666, 21377,  8851, -2647,  -234,   340,   -42,     0 },
+  {   -40,   274,     0, -2740,  7083, 21326,  9451, -2584,  -321,   361,   -42,     0 },
+  {   -38,   253,    68, -2741,  6509, 21241, 10053, -2504,  -413,   382,   -42,     0 },
+  {   -37,   231,   131, -2728,  5944, 21124, 10655, -2405,  -508,   402,   -41,     0 },
+  {   -35,   210,   190, -2703,  5391, 20972, 11257, -2288,  -608,   422,   -39,    -1 },
+  {   -33,   190,   243, -2666,  4850, 20787, 11857, -2151,  -711,   440,   -37,    -1 },
+  {   -31,   170,   291, -2617,  4323, 20570, 12452, -1995,  -817,   457,   -34,    -1 },
+  {   -28,   151,   334, -2559,  3811, 20322, 13041, -1819,  -925,   472,   -30,    -2 },
+  {   -26,   133,   372, -2491,  3314, 20045, 13622, -1622, -1036,   486,   -26,    -3 },
+  {   -24,   115,   406, -2415,  2834, 19737, 14195, -1405, -1149,   498,   -21,    -3 },
+  {   -22,    98,   435, -2332,  2371, 19402, 14756, -1166, -1263,   508,   -15,    -4 },
+  {   -19,    83,   459, -2242,  1927, 19040, 15304,  -907, -1378,   515,    -8,    -6 },
+  {   -17,    68,   479, -2146,  1501, 18650, 15838,  -626, -1492,   520,     0,    -7 },
+  {   -15,    54,   495, -2045,  1096, 18235, 16356,  -323, -1607,   521,     9,    -8 },
+  {   -13,    41,   507, -1940,   710, 17798, 16856,     0, -1720,   520,    19,   -10 },
+  {   -11,    29,   515, -1831,   344, 17339, 17337,   344, -1831,   515,    29,   -11 },
+  {   -10,    19,   520, -1720,     0, 16856, 17798,   710, -1940,   507,    41,   -13 },
+  {    -8,     9,   521, -1607,  -323, 16356, 18235,  1096, -2045,   495,    54,   -15 },
+  {    -7,     0,   520, -1492,  -626, 15838, 18650,  1501, -2146,   479,    68,   -17 },
+  {    -6,    -8,   515, -1378,  -907, 15304, 19040,  1927, -2242,   459,    83,   -19 },
+  {    -4,   -15,   508, -1263, -1166, 14756, 19402,  2371, -2332,   435,    98,   -22 },
+  {    -3,   -21,   498, -1149, -1405, 14195, 19737,  2834, -2415,   406,   115,   -24 },
+  {    -3,   -26,   486, -1036, -1622, 13622, 20045,  3314, -2491,   372,   133,   -26 },
+  {    -2,   -30,   472,  -925, -1819, 13041, 20322,  3811, -2559,   334,   151,   -28 },
+  {    -1,   -34,   457,  -817, -1995, 12452, 20570,  4323, -2617,   291,   170,   -31 },
+  {    -1,   -37,   440,  -711, -2151, 11857, 20787,  4850, -2666,   243,   190,   -33 },
+  {    -1,   -39,   422,  -608, -2288, 11257, 20972,  5391, -2703,   190,   210,   -35 },
+  {     0,   -41,   402,  -508, -2405, 10655, 21124,  5944, -2728,   131,   231,   -37 },
+  {     0,   -42,   382,  -413, -2504, 10053, 21241,  6509, -2741,    68,   253,   -38 },
+  {     0,   -42,   361,  -321, -2584,  9451, 21326,  7083, -2740,     0,   274,   -40 },
+  {     0,   -42,   340,  -234, -2647,  8851, 21377,  7666, -2725,   -73,   296,   -41 }
+};
+
+static const int16_t resample_coef_44100[32][24] PROGMEM = {
+  {    -6,   -21,    15,   159,   258,   -76,  -916, -1347,   172,  4128,  8669, 10698,  8669,  4128,   172, -1347,  -916,   -76,   258,   159,    15,   -21,    -6,     0 },
+  {    -5,   -21,    12,   154,   259,   -56,  -888, -1356,    85,  3980,  8550, 10695,  8785,  4276,   262, -1336,  -943,   -96,   256,   164,    18,   -21,    -6,     0 },
+  {    -5,   -20,     9,   148,   260,   -37,  -860, -1362,     0,  3833,  8429, 10688,  8899,  4425,   355, -1324,  -970,  -117,   254,   170,    21,   -21,    -7,     0 },
+  {    -5,   -20,     7,   143,   261,   -18,  -832, -1367,   -82,  3687,  8305, 10675,  9010,  4575,   450, -1309,  -996,  -138,   251,   175,    24,   -21,    -7,     0 },
+  {    -4,   -20,     4,   137,   261,     0,  -803, -1370,  -162,  3541,  8178, 10663,  9118,  4725,   548, -1292, -1022,  -161,   248,   181,    27,   -21,    -8,     0 },
+  {    -4,   -19,     2,   132,   260,    17,  -775, -1371,  -239,  3397,  8050, 10644,  9223,  4876,   648, -1273, -1048,  -183,   244,   186,    30,   -21,    -8,     0 },
+  {    -3,   -19,     0,   126,   260,    34,  -746, -1370,  -313,  3254,  7919, 10620,  9325,  5026,   751, -1252, -1073,  -206,   240,   191,    34,   -21,    -9,     0 },
+  {    -3,   -19,    -2,   121,   259,    50,  -718, -1368,  -384,  3113,  7787, 10591,  9424,  5177,   856, -1228, -1097,  -230,   235,   196,    38,   -21,    -9,     0 },
+  {    -3,   -18,    -4,   116,   258,    66,  -689, -1364,  -453,  2972,  7652, 10560,  9520,  5328,   963, -1203, -1121,  -254,   230,   201,    41,   -20,   -10,     0 },
+  {    -2,   -18,    -6,   110,   256,    81,  -660, -1358,  -520,  2833,  7516, 10525,  9612,  5478,  1073, -1174, -1144,  -279,   224,   206,    45,   -20,   -10,     0 },
+  {    -2,   -17,    -7,   105,   254,    95,  -632, -1351,  -583,  2695,  7378, 10486,  9701,  5628,  1186, -1144, -1166,  -304,   217,   211,    49,   -20,   -11,     0 },
+  {    -2,   -17,    -9,   100,   252,   108,  -603, -1343,  -644,  2559,  7239, 10441,  9787,  5779,  1300, -1111, -1187,  -329,   210,   215,    53,   -19,   -11,     0 },
+  {    -2,   -16,   -10,    95,   249,   121,  -574, -1333,  -702,  2425,  7097, 10392,  9869,  5928,  1417, -1076, -1208,  -355,   203,   220,    58,   -18,   -12,     0 },
+  {    -2,   -16,   -12,    90,   246,   134,  -546, -1321,  -758,  2292,  6955, 10342,  9948,  6077,  1536, -1038, -1227,  -382,   195,   224,    62,   -18,   -12,    -1 },
+  {    -1,   -15,   -13,    85,   243,   145,  -518, -1309,  -811,  2162,  6811, 10286, 10023,  6226,  1657,  -998, -1246,  -408,   186,   228,    66,   -17,   -13,    -1 },
+  {    -1,   -15,   -14,    80,   240,   157,  -490, -1295,  -862,  2032,  6666, 10226, 10094,  6374,  1780,  -955, -1263,  -435,   177,   232,    71,   -16,   -14,    -1 },
+  {    -1,   -14,   -15,    75,   236,   167,  -463, -1280,  -910,  1905,  6520, 10166, 10162,  6520,  1905,  -910, -1280,  -463,   167,   236,    75,   -15,   -14,    -1 },
+  {    -1,   -14,   -16,    71,   232,   177,  -435, -1263,  -955,  1780,  6374, 10094, 10226,  6666,  2032,  -862, -1295,  -490,   157,   240,    80,   -14,   -15,    -1 },
+  {    -1,   -13,   -17,    66,   228,   186,  -408, -1246,  -998,  1657,  6226, 10023, 10286,  6811,  2162,  -811, -1309,  -518,   145,   243,    85,   -13,   -15,    -1 },
+  {    -1,   -12,   -18,    62,   224,   195,  -382, -1227, -1038,  1536,  6077,  9948, 10342,  6955,  2292,  -758, -1321,  -546,   134,   246,    90,   -12,   -16,    -2 },
+  {     0,   -12,   -18,    58,   220,   203,  -355, -1208, -1076,  1417,  5928,  9869, 10392,  7097,  2425,  -702, -1333,  -574,   121,   249,    95,   -10,   -16,    -2 },
+  {     0,   -11,   -19,    53,   215,   210,  -329, -1187, -1111,  1300,  5779,  9787, 10441,  7239,  2559,  -644, -1343,  -603,   108,   252,   100,    -9,   -17,    -2 },
+  {     0,   -11,   -20,    49,   211,   217,  -304, -1166, -1144,  1186,  5628,  9701, 10486,  7378,  2695,  -583, -1351,  -632,    95,   254,   105,    -7,   -17,    -2 },
+  {     0,   -10,   -20,    45,   206,   224,  -279, -1144, -1174,  1073,  5478,  9612, 10525,  7516,  2833,  -520, -1358,  -660,    81,   256,   110,    -6,   -18,    -2 },
+  {     0,   -10,   -20,    41,   201,   230,  -254, -1121, -1203,   963,  5328,  9520, 10560,  7652,  2972,  -453, -1364,  -689,    66,   258,   116,    -4,   -18,    -3 },
+  {     0,    -9,   -21,    38,   196,   235,  -230, -1097, -1228,   856,  5177,  9424, 10591,  7787,  3113,  -384, -1368,  -718,    50,   259,   121,    -2,   -19,    -3 },
+  {     0,    -9,   -21,    34,   191,   240,  -206, -1073, -1252,   751,  5026,  9325, 10620,  7919,  3254,  -313, -1370,  -746,    34,   260,   126,     0,   -19,    -3 },
+  {     0,    -8,   -21,    30,   186,   244,  -183, -1048, -1273,   648,  4876,  9223, 10644,  8050,  3397,  -239, -1371,  -775,    17,   260,   132,     2,   -19,    -4 },
+  {     0,    -8,   -21,    27,   181,   248,  -161, -1022, -1292,   548,  4725,  9118, 10663,  8178,  3541,  -162, -1370,  -803,     0,   261,   137,     4,   -20,    -4 },
+  {     0,    -7,   -21,    24,   175,   251,  -138,  -996, -1309,   450,  4575,  9010, 10675,  8305,  3687,   -82, -1367,  -832,   -18,   261,   143,     7,   -20,    -5 },
+  {     0,    -7,   -21,    21,   170,   254,  -117,  -970, -1324,   355,  4425,  8899, 10688,  8429,  3833,     0, -1362,  -860,   -37,   260,   148,     9,   -20,    -5 },
+  {     0,    -6,   -21,    18,   164,   256,   -96,  -943, -1336,   262,  4276,  8785, 10695,  8550,  3980,    85, -1356,  -888,   -56,   259,   154,    12,   -21,    -5 }
+};
+
+static const resample_table_t resample_tables[] = {
+  {  8000,  8, &resample_coef_8000[0][0] },
+  { 11025,  8, &resample_coef_11025[0][0] },
+  { 22050, 12, &resample_coef_22050[0][0] },
+  { 44100, 24, &resample_coef_44100[0][0] },
+};
+
+#endif // RESAMPLE_COEF_H_
@@ -0,0 +1,126 @@
+/*!
+ *  \file    ring.c
+ *  \brief   Lock-free single-producer/single-consumer ring buffer
+ *
+ *  \details The consumer functions are inline in ring.h, because they are
+ *           called from interrupts for every sample or block.
+ */
+#include "ring.h"
+
+#include <util/atomic.h>
+
+/*! \brief  Initialize a ring
+ *
+ *  \param  r        ring
+ *  \param  buf      memory of slots << shift bytes
+ *  \param  slots    number of slots, a power of two from 2 up to 128
+ *  \param  shift    log2 of the slot size in bytes
+ *
+ *  \return void
+ */
+void ring_init(ring_t *r, uint8_t *buf, uint8_t slots, uint8_t shift)
+{
+  r->buf   = buf;
+  r->slots = slots;
+  r->mask  = slots - 1;
+  r->shift = shift;
+  ring_reset(r);
+}
+
+/*! \brief  Empty a ring and clear the watermarks
+ *
+ *  \param  r        ring
+ *
+ *  \details Interrupts are disabled during the reset, so it can be called
+ *           while the consumer interrupt is still enabled.
+ *
+ *  \return void
+ */
+void ring_reset(ring_t *r)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    r->head  = 0;
+    r->tail  = 0;
+    r->claim = 0;
+    r->rpos  = 0;
+    r->low   = r->slots;
+    r->high  = 0;
+  }
+}
+
+/*! \brief  Drop the data that the consumer has not taken (producer side)
+ *
+ *  \param  r        ring
+ *
+ *  \details Slots claimed with ring_claim() stay owned by the consumer and
+ *           are given back with ring_release() as usual, so the ring can be
+ *           flushed while the DMA still transfers them. Their memory is not
+ *           reserved again before they are released. A slot that is partly
+ *           read with ring_read_ptr() is dropped. The watermarks are
+ *           cleared.
+ *
+ *  \return void
+ */
+void ring_flush(ring_t *r)
+{
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    r->head = r->claim;
+    r->rpos = 0;
+    r->low  = r->slots;
+    r->high = 0;
+  }
+}
+
+/*! \brief  Get contiguous free memory (producer side)
+ *
+ *  \param  r        ring
+ *  \param  len      pointer to store the number of free bytes
+ *
+ *  \details The memory runs up to the first slot that is still in use or
+ *           to the end of the buffer, whichever comes first. It may be 0.
+ *
+ *  \return pointer to the free memory
+ */
+uint8_t *ring_reserve(ring_t *r, uint16_t *len)
+{
+  uint8_t idx  = r->head & r->mask;
+  uint8_t free = r->slots - (uint8_t) (r->head - r->tail);
+  uint8_t n    = r->slots - idx;                // slots up to the end of buf
+
+  if (free < n) n = free;
+  *len = (uint16_t) n << r->shift;
+
+  return r->buf + ((uint16_t) idx << r->shift);
+}
+
+/*! \brief  Publish reserved memory to the consumer (producer side)
+ *
+ *  \param  r        ring
+ *  \param  len      number of bytes written, rounded up to whole slots
+ *
+ *  \return void
+ */
+void ring_commit(ring_t *r, uint16_t len)
+{
+  uint8_t n = (len + (1u << r->shift) - 1) >> r->shift;
+  uint8_t used;
+
+  __asm__ __volatile__ ("" ::: "memory");       // writes of the data are done
+  r->head += n;
+  used = (uint8_t) (r->head - r->tail);
+  if (used > r->high) r->high = used;
+}
+
+/*! \brief  Restart the watermarks from the current fill level
+ *
+ *  \param  r        ring
+ *
+ *  \return void
+ */
+void ring_clear_watermarks(ring_t *r)
+{
+  uint8_t used = ring_used(r);
+
+  r->low  = used;
+  r->high = used;
+}
@@ -0,0 +1,127 @@
+/*!
+ *  \file    ring.h
+ *  \brief   Lock-free single-producer/single-consumer ring buffer
+ *
+ *  \details The ring is divided in a power-of-two number of slots of a
+ *           power-of-two size. The producer (main loop) and the consumer
+ *           (interrupt) only share the slot counters head and tail. These
+ *           are free running bytes that are masked when used as an index, so
+ *           they are read and written atomically on the 8-bit Xmega and no
+ *           interrupts have to be disabled. A ring has at most 128 slots.
+ *
+ *           The producer gets contiguous free memory with ring_reserve(),
+ *           fills it (for example directly with f_read()) and publishes it
+ *           with ring_commit(). Commits are rounded up to whole slots.
+ *
+ *           The consumer either reads the data piecewise with ring_read_ptr()
+ *           and ring_read_advance(), or takes whole slots with ring_claim()
+ *           and gives them back with ring_release() (for DMA). Elements must
+ *           not cross a slot border. ring_flush() empties the ring while
+ *           claimed slots are still owned by the consumer.
+ *
+ *           The ring keeps a high watermark (most slots filled at a commit)
+ *           and a low watermark (fewest slots filled after a release), so the
+ *           ring can be sized from the measured load.
+ */
+#ifndef RING_H_
+#define RING_H_
+
+#include <stdint.h>
+
+/*! \brief  Ring buffer administration */
+typedef struct {
+  uint8_t          *buf;        //!< slots * slot size bytes
+  uint8_t           slots;      //!< number of slots (power of two)
+  uint8_t           mask;       //!< slots - 1
+  uint8_t           shift;      //!< log2 of the slot size
+  volatile uint8_t  head;       //!< slots committed (producer)
+  volatile uint8_t  tail;       //!< slots released (consumer)
+  uint8_t           claim;      //!< slots claimed (consumer), follows tail when read piecewise
+  uint16_t          rpos;       //!< read position in the tail slot (consumer)
+  volatile uint8_t  low;        //!< low watermark in slots
+  volatile uint8_t  high;       //!< high watermark in slots
+} ring_t;
+
+void     ring_init(ring_t *r, uint8_t *buf, uint8_t slots, uint8_t shift);
+void     ring_reset(ring_t *r);
+void     ring_flush(ring_t *r);
+uint8_t *ring_reserve(ring_t *r, uint16_t *len);
+void     ring_commit(ring_t *r, uint16_t len);
+void     ring_clear_watermarks(ring_t *r);
+
+/*! \brief  Number of filled slots
+ *
+ *  \param  r        ring
+ *
+ *  \return slots committed and not yet released
+ */
+static inline uint8_t ring_used(const ring_t *r)
+{
+  return (uint8_t) (r->head - r->tail);
+}
+
+/*! \brief  Give the oldest slot back to the producer (consumer side)
+ *
+ *  \param  r        ring
+ *
+ *  \return void
+ */
+static inline void ring_release(ring_t *r)
+{
+  uint8_t used;
+
+  __asm__ __volatile__ ("" ::: "memory");       // reads of the slot are done
+  r->tail++;
+  used = (uint8_t) (r->head - r->tail);
+  if (used < r->low) r->low = used;
+}
+
+/*! \brief  Claim the next whole slot (consumer side, block mode)
+ *
+ *  \param  r        ring
+ *
+ *  \return pointer to the slot or 0 if no committed slot is left
+ */
+static inline const uint8_t *ring_claim(ring_t *r)
+{
+  uint8_t n = r->claim;
+
+  if (n == r->head) return 0;
+  r->claim = n + 1;
+
+  return r->buf + ((uint16_t) (n & r->mask) << r->shift);
+}
+
+/*! \brief  Get a pointer to the unread data (consumer side)
+ *
+ *  \param  r        ring
+ *
+ *  \return pointer to the next unread byte or 0 if the ring is empty
+ */
+static inline const uint8_t *ring_read_ptr(const ring_t *r)
+{
+  uint8_t n = r->tail;
+
+  if (n == r->head) return 0;
+
+  return r->buf + ((uint16_t) (n & r->mask) << r->shift) + r->rpos;
+}
+
+/*! \brief  Mark bytes as read (consumer side)
+ *
+ *  \param  r        ring
+ *  \param  n        number of bytes read, must not cross the slot border
+ *
+ *  \return void
+ */
+static inline void ring_read_advance(ring_t *r, uint8_t n)
+{
+  r->rpos += n;
+  if (r->rpos >> r->shift) {
+    r->rpos = 0;
+    r->claim++;                         // for ring_flush()
+    ring_release(r);
+  }
+}
+
+#endif // RING_H_
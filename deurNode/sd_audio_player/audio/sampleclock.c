@@ -0,0 +1,81 @@
+/*!
+ *  \file    sampleclock.c
+ *  \brief   Sample clock on TCC0 with an exact average rate
+ *
+ *  \details F_CPU = base * rate + rem. Per step the accumulator grows with
+ *           rem; when it passes rate the next period is base + 1 cycles,
+ *           otherwise base cycles. After rate steps exactly rem long
+ *           periods have been made, so rate periods take F_CPU cycles.
+ *
+ *           The new period is written to TCC0.PERBUF and takes effect at the
+ *           next overflow, so the running period is never cut short.
+ */
+#ifndef F_CPU
+#define F_CPU 32000000UL
+#endif
+
+#include "sampleclock.h"
+
+#include <avr/io.h>
+#include <util/atomic.h>
+
+static uint16_t clk_rate = 16000;       //!< samples per second
+static uint16_t clk_base = F_CPU / 16000;
+static uint16_t clk_rem  = 0;           //!< F_CPU % rate
+static uint16_t clk_acc  = 0;           //!< fractional accumulator, < rate
+
+/*! \brief  Program TCC0 for a sample rate
+ *
+ *  \param  rate     sample rate in Hz, from SAMPLECLOCK_MIN to SAMPLECLOCK_MAX
+ *
+ *  \details The timer is not started or stopped. It can be called while the
+ *           timer runs; the new period starts at the next overflow.
+ *
+ *  \return 1 if the rate is set, 0 if it is out of range
+ */
+uint8_t sampleclock_set(uint32_t rate)
+{
+  if (rate < SAMPLECLOCK_MIN || rate > SAMPLECLOCK_MAX) {
+    return 0;
+  }
+
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    clk_rate = rate;
+    clk_base = F_CPU / rate;
+    clk_rem  = F_CPU % rate;
+    clk_acc  = 0;
+    TCC0.PERBUF = clk_base - 1;
+    if ( (TCC0.CTRLA & TC0_CLKSEL_gm) == TC_CLKSEL_OFF_gc ) {
+      TCC0.PER = clk_base - 1;          // timer stopped: no update will come
+    }
+  }
+
+  return 1;
+}
+
+/*! \brief  Get the programmed sample rate
+ *
+ *  \return sample rate in Hz
+ */
+uint16_t sampleclock_rate(void)
+{
+  return clk_rate;
+}
+
+/*! \brief  Select the next period. Call this function once per sample or
+ *          once per block from the output interrupt.
+ *
+ *  \return void
+ */
+void sampleclock_step(void)
+{
+  if (clk_rem == 0) return;             // rate divides F_CPU
+
+  if (clk_acc >= clk_rate - clk_rem) {  // acc + rem >= rate without overflow
+    clk_acc -= clk_rate - clk_rem;
+    TCC0.PERBUF = clk_base;             // base + 1 cycles
+  } else {
+    clk_acc += clk_rem;
+    TCC0.PERBUF = clk_base - 1;         // base cycles
+  }
+}
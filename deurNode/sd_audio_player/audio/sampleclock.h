@@ -0,0 +1,29 @@
+/*!
+ *  \file    sampleclock.h
+ *  \brief   Sample clock on TCC0 with an exact average rate
+ *
+ *  \details The period of TCC0 is F_CPU / rate clock cycles. If the rate does
+ *           not divide F_CPU (44100, 22050, 11025 Hz at 32 MHz) the period is
+ *           switched between the two nearest whole values with a fractional
+ *           accumulator, so the average rate is exact and long clips neither
+ *           drift nor change pitch.
+ *
+ *           sampleclock_step() must be called once per period in which the
+ *           accumulator runs: per sample from the TCC0 overflow interrupt or
+ *           per block from the DMA block interrupt. In the last case all
+ *           samples of a block have the same period; the average rate stays
+ *           exact.
+ */
+#ifndef SAMPLECLOCK_H_
+#define SAMPLECLOCK_H_
+
+#include <stdint.h>
+
+#define SAMPLECLOCK_MIN   500           //!< lowest rate, TCC0 period fits in 16 bits
+#define SAMPLECLOCK_MAX   48000         //!< highest rate
+
+uint8_t  sampleclock_set(uint32_t rate);
+uint16_t sampleclock_rate(void);
+void     sampleclock_step(void);
+
+#endif // SAMPLECLOCK_H_
@@ -0,0 +1,200 @@
+/*!
+ *  \file    soundbank.c
+ *  \brief   Sound bank container on the SD-card
+ *
+ *  \details The index is kept in RAM together with the first sector of the
+ *           bank on the card. The bank must be contiguous; this is checked
+ *           with a cluster link map table of one fragment (FF_USE_FASTSEEK).
+ */
+#include "soundbank.h"
+
+#include <string.h>
+
+static soundbank_entry_t entries[SOUNDBANK_CLIPS];  //!< index of the mounted bank
+static uint8_t           count;                     //!< clips in entries[], 0: no bank
+static LBA_t             base;                      //!< sector of the start of the bank
+static BYTE              drive;                     //!< physical drive of the bank
+
+/*! \brief  FNV-1a hash
+ *
+ *  \param  p        bytes
+ *  \param  n        number of bytes
+ *
+ *  \return 32-bit hash
+ */
+static uint32_t fnv1a(const uint8_t *p, uint16_t n)
+{
+  uint32_t h = 2166136261UL;
+
+  while (n--) {
+    h ^= *p++;
+    h *= 16777619UL;
+  }
+
+  return h;
+}
+
+/*! \brief  Check an index entry against the header
+ *
+ *  \param  e        entry
+ *  \param  h        header of the bank
+ *
+ *  \return 1 if the entry is valid, 0 otherwise
+ */
+static uint8_t entry_valid(const soundbank_entry_t *e, const soundbank_header_t *h)
+{
+  uint32_t sectors = (e->length + SOUNDBANK_SECTOR - 1) / SOUNDBANK_SECTOR;
+
+  return (e->format == WAV_FORMAT_PCM || e->format == WAV_FORMAT_IMA_ADPCM) &&
+         e->channels && e->rate && e->block_align &&
+         e->sector >= h->index_sectors && e->sector <= h->sectors &&
+         sectors <= h->sectors - e->sector;
+}
+
+/*! \brief  Read and check the header and the index of an open bank
+ *
+ *  \param  fp       bank, at the start
+ *  \param  h        pointer to store the header
+ *
+ *  \return FR_OK, FR_INVALID_OBJECT if the file is not a valid bank,
+ *          FR_NOT_ENOUGH_CORE if it has more than SOUNDBANK_CLIPS clips or
+ *          the FatFs error code
+ */
+static FRESULT read_index(FIL *fp, soundbank_header_t *h)
+{
+  FRESULT  res;
+  UINT     br;
+  uint16_t len;
+  uint8_t  i;
+
+  if ( (res = f_read(fp, h, sizeof(*h), &br)) != FR_OK ) {
+    return res;
+  }
+  len = h->count * sizeof(soundbank_entry_t);
+  if ( br != sizeof(*h) || strncmp(h->magic, "SBNK", 4) || h->version != SOUNDBANK_VERSION ||
+       (uint32_t) h->index_sectors * SOUNDBANK_SECTOR < sizeof(*h) + len ||
+       h->sectors < h->index_sectors ||
+       f_size(fp) < (FSIZE_t) h->sectors * SOUNDBANK_SECTOR ) {
+    return FR_INVALID_OBJECT;
+  }
+  if (h->count > SOUNDBANK_CLIPS) {
+    return FR_NOT_ENOUGH_CORE;
+  }
+  if ( (res = f_read(fp, entries, len, &br)) != FR_OK ) {
+    return res;
+  }
+  if ( br != len || fnv1a((const uint8_t *) entries, len) != h->hash ) {
+    return FR_INVALID_OBJECT;
+  }
+  for (i = 0; i < h->count; i++) {
+    if ( !entry_valid(&entries[i], h) ) return FR_INVALID_OBJECT;
+  }
+
+  return FR_OK;
+}
+
+/*! \brief  Open a sound bank and read its index
+ *
+ *  \param  path     name of the bank on the mounted volume
+ *
+ *  \details Call this function after f_mount() and before the first
+ *           player_clip(). The file is closed again; only the index and the
+ *           sector address are kept. A bank that was mounted before is
+ *           replaced.
+ *
+ *  \return FR_OK, FR_INVALID_OBJECT if the file is not a valid bank,
+ *          FR_NOT_ENOUGH_CORE if it has more than SOUNDBANK_CLIPS clips,
+ *          FR_DENIED if it is fragmented or the FatFs error code
+ */
+FRESULT soundbank_mount(const char *path)
+{
+  FIL                fp;
+  soundbank_header_t h;
+  DWORD              clmt[4];
+  FRESULT            res;
+
+  count = 0;
+  if ( (res = f_open(&fp, path, FA_READ)) != FR_OK ) {
+    return res;
+  }
+  if ( (res = read_index(&fp, &h)) == FR_OK ) {
+    fp.cltbl = clmt;                    // one fragment: size, length, cluster, 0
+    clmt[0]  = sizeof(clmt) / sizeof(clmt[0]);
+    res = f_lseek(&fp, CREATE_LINKMAP);
+    if (res == FR_NOT_ENOUGH_CORE) res = FR_DENIED;
+  }
+  if (res == FR_OK) {
+    base  = fp.obj.fs->database + (LBA_t) (clmt[2] - 2) * fp.obj.fs->csize;
+    drive = fp.obj.fs->pdrv;
+    count = h.count;
+  }
+  f_close(&fp);
+
+  return res;
+}
+
+/*! \brief  Forget the mounted bank, for example when the card is removed
+ *
+ *  \return void
+ */
+void soundbank_unmount(void)
+{
+  count = 0;
+}
+
+/*! \brief  Get the number of clips in the mounted bank
+ *
+ *  \return number of clips, 0 if no bank is mounted
+ */
+uint8_t soundbank_count(void)
+{
+  return count;
+}
+
+/*! \brief  Look up a clip
+ *
+ *  \param  id       number of the clip
+ *  \param  info     pointer to store the format of the clip; data_offset
+ *                   is 0 and data_size is the number of data bytes
+ *  \param  sector   pointer to store the sector of the first data byte
+ *
+ *  \return FR_OK, FR_NO_FILE if the clip is not in the bank or
+ *          FR_NOT_ENABLED if no bank is mounted
+ */
+FRESULT soundbank_clip(uint16_t id, wav_info_t *info, LBA_t *sector)
+{
+  const soundbank_entry_t *e;
+  uint8_t                  i;
+
+  if (count == 0) return FR_NOT_ENABLED;
+
+  for (i = 0, e = entries; i < count; i++, e++) {
+    if (e->id == id) {
+      info->format      = e->format;
+      info->channels    = e->channels;
+      info->sample_rate = e->rate;
+      info->block_align = e->block_align;
+      info->bits        = e->format == WAV_FORMAT_PCM ? e->block_align * 8 / e->channels : 4;
+      info->data_offset = 0;
+      info->data_size   = e->length;
+      info->loop_start  = 0;
+      info->loop_end    = 0;
+      *sector = base + e->sector;
+      return FR_OK;
+    }
+  }
+
+  return FR_NO_FILE;
+}
+
+/*! \brief  Get the physical drive of the mounted bank
+ *
+ *  \details The sectors of a clip are read with disk_read() on this drive,
+ *           past the file system.
+ *
+ *  \return drive number for disk_read()
+ */
+BYTE soundbank_drive(void)
+{
+  return drive;
+}
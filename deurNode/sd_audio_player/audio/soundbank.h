@@ -0,0 +1,65 @@
+/*!
+ *  \file    soundbank.h
+ *  \brief   Sound bank container on the SD-card
+ *
+ *  \details A sound bank is one file with many clips. It is made on the PC
+ *           by tools/sbpack.c and checked by tools/sbcheck.c. All numbers
+ *           are little endian. The file starts with the index:
+ *           <ul><li>a soundbank_header_t of 16 bytes
+ *           </li><li>a soundbank_entry_t of 16 bytes per clip
+ *           </li></ul>
+ *           padded to index_sectors whole sectors. The audio data of every
+ *           clip (the "data" chunk of its WAV file, as it is) follows,
+ *           starting at a sector boundary and padded to whole sectors.
+ *
+ *           soundbank_mount() opens the file once, copies the index to RAM
+ *           and checks that the file is contiguous on the card. After that a
+ *           clip goes from its id straight to a sector address: no directory
+ *           lookup and no header parsing, the samples are read with
+ *           disk_read() from soundbank_drive(). See player_clip().
+ *
+ *           Copy the bank to the card as one file. A fragmented bank is
+ *           refused; copy it again to a freshly formatted card.
+ */
+#ifndef SOUNDBANK_H_
+#define SOUNDBANK_H_
+
+#include <stdint.h>
+#include "../ff/ff.h"
+#include "wav.h"
+
+#ifndef SOUNDBANK_CLIPS
+#define SOUNDBANK_CLIPS     16      //!< clips kept in the RAM index
+#endif
+
+#define SOUNDBANK_SECTOR    512     //!< bytes per sector
+#define SOUNDBANK_VERSION   1       //!< version of the format
+
+/*! \brief  Start of the file */
+typedef struct {
+  char     magic[4];            //!< "SBNK"
+  uint8_t  version;             //!< SOUNDBANK_VERSION
+  uint8_t  count;               //!< number of clips
+  uint16_t index_sectors;       //!< sectors of the header and the index
+  uint32_t sectors;             //!< sectors of the whole bank
+  uint32_t hash;                //!< FNV-1a hash of the index entries
+} soundbank_header_t;
+
+/*! \brief  Index entry of a clip */
+typedef struct {
+  uint16_t id;                  //!< number of the clip, unique in the bank
+  uint8_t  format;              //!< WAV_FORMAT_PCM or WAV_FORMAT_IMA_ADPCM
+  uint8_t  channels;            //!< number of channels
+  uint16_t rate;                //!< samples per second
+  uint16_t block_align;         //!< bytes per frame (PCM) or per block (ADPCM)
+  uint32_t sector;              //!< first sector of the data, from the start of the file
+  uint32_t length;              //!< bytes of audio data
+} soundbank_entry_t;
+
+FRESULT  soundbank_mount(const char *path);
+void     soundbank_unmount(void);
+uint8_t  soundbank_count(void);
+FRESULT  soundbank_clip(uint16_t id, wav_info_t *info, LBA_t *sector);
+BYTE     soundbank_drive(void);
+
+#endif // SOUNDBANK_H_
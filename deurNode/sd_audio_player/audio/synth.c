@@ -0,0 +1,446 @@
+/*!
+ *  \file    synth.c
+ *  \brief   Wavetable tone synthesizer for chimes, beeps and alarms
+ *
+ *  \details Per sample and tone the work is a 32-bit phase add, a table
+ *           read from flash and an 8 x 8 bit multiply with the envelope.
+ *           A tone at full level swings +-508 around mid-scale, so four
+ *           tones do not clip. The tones are summed as int16_t and limited
+ *           to the DAC range once per sample.
+ */
+#include "synth.h"
+#include "gain.h"
+
+#include <avr/pgmspace.h>
+
+#define STAGE_OFF       0       //!< tone is silent and free
+#define STAGE_ATTACK    1
+#define STAGE_DECAY     2
+#define STAGE_SUSTAIN   3
+#define STAGE_RELEASE   4
+
+#define LEVEL_MAX       0xFF00  //!< full envelope level, 8.8
+
+static const int8_t wave_sine[256] PROGMEM = {
+     0,    3,    6,    9,   12,   16,   19,   22,   25,   28,   31,   34,   37,   40,   43,   46,
+    49,   51,   54,   57,   60,   63,   65,   68,   71,   73,   76,   78,   81,   83,   85,   88,
+    90,   92,   94,   96,   98,  100,  102,  104,  106,  107,  109,  111,  112,  113,  115,  116,
+   117,  118,  120,  121,  122,  122,  123,  124,  125,  125,  126,  126,  126,  127,  127,  127,
+   127,  127,  127,  127,  126,  126,  126,  125,  125,  124,  123,  122,  122,  121,  120,  118,
+   117,  116,  115,  113,  112,  111,  109,  107,  106,  104,  102,  100,   98,   96,   94,   92,
+    90,   88,   85,   83,   81,   78,   76,   73,   71,   68,   65,   63,   60,   57,   54,   51,
+    49,   46,   43,   40,   37,   34,   31,   28,   25,   22,   19,   16,   12,    9,    6,    3,
+     0,   -3,   -6,   -9,  -12,  -16,  -19,  -22,  -25,  -28,  -31,  -34,  -37,  -40,  -43,  -46,
+   -49,  -51,  -54,  -57,  -60,  -63,  -65,  -68,  -71,  -73,  -76,  -78,  -81,  -83,  -85,  -88,
+   -90,  -92,  -94,  -96,  -98, -100, -102, -104, -106, -107, -109, -111, -112, -113, -115, -116,
+  -117, -118, -120, -121, -122, -122, -123, -124, -125, -125, -126, -126, -126, -127, -127, -127,
+  -127, -127, -127, -127, -126, -126, -126, -125, -125, -124, -123, -122, -122, -121, -120, -118,
+  -117, -116, -115, -113, -112, -111, -109, -107, -106, -104, -102, -100,  -98,  -96,  -94,  -92,
+   -90,  -88,  -85,  -83,  -81,  -78,  -76,  -73,  -71,  -68,  -65,  -63,  -60,  -57,  -54,  -51,
+   -49,  -46,  -43,  -40,  -37,  -34,  -31,  -28,  -25,  -22,  -19,  -16,  -12,   -9,   -6,   -3
+};
+
+static const int8_t wave_triangle[256] PROGMEM = {
+     0,    2,    4,    6,    8,   10,   12,   14,   16,   18,   20,   22,   24,   26,   28,   30,
+    32,   34,   36,   38,   40,   42,   44,   46,   48,   50,   52,   54,   56,   58,   60,   62,
+    64,   65,   67,   69,   71,   73,   75,   77,   79,   81,   83,   85,   87,   89,   91,   93,
+    95,   97,   99,  101,  103,  105,  107,  109,  111,  113,  115,  117,  119,  121,  123,  125,
+   127,  125,  123,  121,  119,  117,  115,  113,  111,  109,  107,  105,  103,  101,   99,   97,
+    95,   93,   91,   89,   87,   85,   83,   81,   79,   77,   75,   73,   71,   69,   67,   65,
+    64,   62,   60,   58,   56,   54,   52,   50,   48,   46,   44,   42,   40,   38,   36,   34,
+    32,   30,   28,   26,   24,   22,   20,   18,   16,   14,   12,   10,    8,    6,    4,    2,
+     0,   -2,   -4,   -6,   -8,  -10,  -12,  -14,  -16,  -18,  -20,  -22,  -24,  -26,  -28,  -30,
+   -32,  -34,  -36,  -38,  -40,  -42,  -44,  -46,  -48,  -50,  -52,  -54,  -56,  -58,  -60,  -62,
+   -64,  -65,  -67,  -69,  -71,  -73,  -75,  -77,  -79,  -81,  -83,  -85,  -87,  -89,  -91,  -93,
+   -95,  -97,  -99, -101, -103, -105, -107, -109, -111, -113, -115, -117, -119, -121, -123, -125,
+  -127, -125, -123, -121, -119, -117, -115, -113, -111, -109, -107, -105, -103, -101,  -99,  -97,
+   -95,  -93,  -91,  -89,  -87,  -85,  -83,  -81,  -79,  -77,  -75,  -73,  -71,  -69,  -67,  -65,
+   -64,  -62,  -60,  -58,  -56,  -54,  -52,  -50,  -48,  -46,  -44,  -42,  -40,  -38,  -36,  -34,
+   -32,  -30,  -28,  -26,  -24,  -22,  -20,  -18,  -16,  -14,  -12,  -10,   -8,   -6,   -4,   -2
+};
+
+static const int8_t wave_square[256] PROGMEM = {
+     0,   18,   36,   52,   67,   79,   88,   95,   99,  100,   99,   97,   94,   90,   86,   82,
+    79,   77,   76,   76,   78,   79,   82,   84,   87,   89,   90,   91,   91,   90,   89,   87,
+    85,   83,   82,   81,   80,   80,   80,   81,   83,   84,   86,   87,   88,   89,   89,   89,
+    88,   87,   85,   84,   83,   82,   81,   81,   81,   82,   83,   84,   85,   87,   88,   88,
+    89,   88,   88,   87,   85,   84,   83,   82,   81,   81,   81,   82,   83,   84,   85,   87,
+    88,   89,   89,   89,   88,   87,   86,   84,   83,   81,   80,   80,   80,   81,   82,   83,
+    85,   87,   89,   90,   91,   91,   90,   89,   87,   84,   82,   79,   78,   76,   76,   77,
+    79,   82,   86,   90,   94,   97,   99,  100,   99,   95,   88,   79,   67,   52,   36,   18,
+     0,  -18,  -36,  -52,  -67,  -79,  -88,  -95,  -99, -100,  -99,  -97,  -94,  -90,  -86,  -82,
+   -79,  -77,  -76,  -76,  -78,  -79,  -82,  -84,  -87,  -89,  -90,  -91,  -91,  -90,  -89,  -87,
+   -85,  -83,  -82,  -81,  -80,  -80,  -80,  -81,  -83,  -84,  -86,  -87,  -88,  -89,  -89,  -89,
+   -88,  -87,  -85,  -84,  -83,  -82,  -81,  -81,  -81,  -82,  -83,  -84,  -85,  -87,  -88,  -88,
+   -89,  -88,  -88,  -87,  -85,  -84,  -83,  -82,  -81,  -81,  -81,  -82,  -83,  -84,  -85,  -87,
+   -88,  -89,  -89,  -89,  -88,  -87,  -86,  -84,  -83,  -81,  -80,  -80,  -80,  -81,  -82,  -83,
+   -85,  -87,  -89,  -90,  -91,  -91,  -90,  -89,  -87,  -84,  -82,  -79,  -78,  -76,  -76,  -77,
+   -79,  -82,  -86,  -90,  -94,  -97,  -99, -100,  -99,  -95,  -88,  -79,  -67,  -52,  -36,  -18
+};
+
+static const int8_t wave_saw[256] PROGMEM = {
+     0,    0,    0,    0,    0,    1,    1,    2,    3,    4,    5,    6,    7,    9,   10,   12,
+    14,   15,   17,   18,   20,   21,   22,   23,   23,   24,   24,   24,   24,   24,   24,   24,
+    24,   24,   24,   25,   25,   26,   26,   27,   28,   30,   31,   33,   35,   36,   38,   40,
+    41,   43,   44,   46,   47,   48,   48,   49,   49,   49,   49,   49,   48,   48,   48,   48,
+    48,   48,   48,   48,   49,   50,   51,   53,   55,   56,   58,   61,   63,   65,   67,   69,
+    71,   72,   73,   74,   75,   75,   75,   75,   74,   73,   72,   71,   70,   69,   69,   68,
+    68,   68,   69,   70,   71,   74,   76,   79,   82,   86,   90,   93,   97,  101,  104,  107,
+   109,  110,  110,  109,  107,  104,  100,   94,   88,   80,   71,   61,   50,   38,   26,   13,
+     0,  -13,  -26,  -38,  -50,  -61,  -71,  -80,  -88,  -94, -100, -104, -107, -109, -110, -110,
+  -109, -107, -104, -101,  -97,  -93,  -90,  -86,  -82,  -79,  -76,  -74,  -71,  -70,  -69,  -68,
+   -68,  -68,  -69,  -69,  -70,  -71,  -72,  -73,  -74,  -75,  -75,  -75,  -75,  -74,  -73,  -72,
+   -71,  -69,  -67,  -65,  -63,  -61,  -58,  -56,  -55,  -53,  -51,  -50,  -49,  -48,  -48,  -48,
+   -48,  -48,  -48,  -48,  -48,  -49,  -49,  -49,  -49,  -49,  -48,  -48,  -47,  -46,  -44,  -43,
+   -41,  -40,  -38,  -36,  -35,  -33,  -31,  -30,  -28,  -27,  -26,  -26,  -25,  -25,  -24,  -24,
+   -24,  -24,  -24,  -24,  -24,  -24,  -24,  -24,  -23,  -23,  -22,  -21,  -20,  -18,  -17,  -15,
+   -14,  -12,  -10,   -9,   -7,   -6,   -5,   -4,   -3,   -2,   -1,   -1,    0,    0,    0,    0
+};
+
+static const int8_t wave_bell[256] PROGMEM = {
+     0,    8,   17,   25,   33,   41,   49,   57,   64,   71,   77,   84,   89,   95,  100,  104,
+   108,  112,  115,  118,  121,  123,  124,  125,  126,  127,  127,  127,  127,  126,  125,  125,
+   124,  122,  121,  120,  119,  117,  116,  115,  113,  112,  111,  110,  108,  107,  106,  105,
+   104,  103,  102,  101,  100,   99,   97,   96,   95,   93,   92,   90,   88,   86,   84,   82,
+    80,   78,   75,   73,   70,   67,   64,   62,   59,   56,   53,   50,   47,   45,   42,   40,
+    37,   35,   33,   32,   30,   29,   28,   27,   26,   26,   26,   26,   26,   27,   28,   28,
+    29,   31,   32,   33,   34,   36,   37,   38,   39,   40,   41,   42,   42,   43,   43,   42,
+    42,   41,   40,   39,   37,   35,   33,   30,   28,   25,   22,   18,   15,   11,    8,    4,
+     0,   -4,   -8,  -11,  -15,  -18,  -22,  -25,  -28,  -30,  -33,  -35,  -37,  -39,  -40,  -41,
+   -42,  -42,  -43,  -43,  -42,  -42,  -41,  -40,  -39,  -38,  -37,  -36,  -34,  -33,  -32,  -31,
+   -29,  -28,  -28,  -27,  -26,  -26,  -26,  -26,  -26,  -27,  -28,  -29,  -30,  -32,  -33,  -35,
+   -37,  -40,  -42,  -45,  -47,  -50,  -53,  -56,  -59,  -62,  -64,  -67,  -70,  -73,  -75,  -78,
+   -80,  -82,  -84,  -86,  -88,  -90,  -92,  -93,  -95,  -96,  -97,  -99, -100, -101, -102, -103,
+  -104, -105, -106, -107, -108, -110, -111, -112, -113, -115, -116, -117, -119, -120, -121, -122,
+  -124, -125, -125, -126, -127, -127, -127, -127, -126, -125, -124, -123, -121, -118, -115, -112,
+  -108, -104, -100,  -95,  -89,  -84,  -77,  -71,  -64,  -57,  -49,  -41,  -33,  -25,  -17,   -8
+};
+
+static const int8_t * const waves[SYNTH_WAVES] = {
+  wave_sine, wave_triangle, wave_square, wave_saw, wave_bell
+};
+
+/*! \brief  Frequency of the notes of octave 7 (MIDI 96 .. 107) in 1/16 Hz */
+static const uint16_t octave7[12] PROGMEM = {
+  33488, 35479, 37589, 39824, 42192, 44701, 47359, 50175, 53159, 56320, 59669, 63217
+};
+
+const uint8_t synth_chime[] PROGMEM = {
+  SYNTH_PATTERN(SYNTH_BELL, 0, 150, 0, 60, 10, 1),
+  SYNTH_NOTE(E, 5), 40, SYNTH_NOTE(C, 5), 0, SYNTH_NOTE(C, 4), 120, SYNTH_END
+};
+
+const uint8_t synth_beep[] PROGMEM = {
+  SYNTH_PATTERN(SYNTH_SINE, 1, 0, 255, 2, 10, 1),
+  SYNTH_NOTE(A, 5), 15, SYNTH_END
+};
+
+const uint8_t synth_alarm[] PROGMEM = {
+  SYNTH_PATTERN(SYNTH_SQUARE, 1, 0, 255, 1, 10, 0),
+  SYNTH_NOTE(B, 5), 25, SYNTH_NOTE(E, 5), 25, SYNTH_END
+};
+
+static cycles_t synth_load;             //!< cycles in synth_source()
+static uint32_t synth_samples;          //!< samples made
+
+/*! \brief  Envelope step for a time in a pattern header
+ *
+ *  \param  s        synthesizer
+ *  \param  units    time in units of SYNTH_MS_UNIT
+ *  \param  range    level change over the time, 8.8
+ *
+ *  \return level change per control step, range for a time of 0
+ */
+static uint16_t env_step(const synth_t *s, uint8_t units, uint16_t range)
+{
+  uint32_t steps = (uint32_t) units * SYNTH_MS_UNIT * s->rate / (1000UL * SYNTH_CTRL);
+
+  if (steps == 0) return range ? range : 1;
+
+  return range / steps ? range / steps : 1;
+}
+
+/*! \brief  Phase step of a note
+ *
+ *  \param  s        synthesizer
+ *  \param  note     MIDI number, 12 (C0) .. 107 (B7)
+ *
+ *  \return phase step per sample
+ */
+static uint32_t note_inc(const synth_t *s, uint8_t note)
+{
+  uint16_t f;
+
+  if (note < 12)  note = 12;
+  if (note > 107) note = 107;
+  f = pgm_read_word(&octave7[note % 12]) >> (8 - note / 12);
+
+  return (uint32_t) f * s->k;
+}
+
+/*! \brief  Let all sounding tones fade out
+ *
+ *  \param  s        synthesizer
+ *
+ *  \return void
+ */
+static void release_all(synth_t *s)
+{
+  uint8_t i;
+
+  for (i = 0; i < SYNTH_TONES; i++) {
+    if (s->tone[i].stage != STAGE_OFF) s->tone[i].stage = STAGE_RELEASE;
+  }
+}
+
+/*! \brief  Start a note on the quietest tone
+ *
+ *  \param  s        synthesizer
+ *  \param  note     MIDI number
+ *
+ *  \return void
+ */
+static void note_on(synth_t *s, uint8_t note)
+{
+  synth_tone_t *t = &s->tone[0];
+  uint8_t       i;
+
+  for (i = 0; i < SYNTH_TONES; i++) {
+    if (s->tone[i].stage == STAGE_OFF) {
+      t = &s->tone[i];                  // a free tone is always the best
+      break;
+    }
+    if (s->tone[i].level < t->level) t = &s->tone[i];
+  }
+
+  t->phase = 0;
+  t->inc   = note_inc(s, note);
+  t->wave  = waves[pgm_read_byte(s->pattern) % SYNTH_WAVES];
+  t->level = 0;
+  t->stage = STAGE_ATTACK;
+}
+
+/*! \brief  Play the events of the pattern that are due
+ *
+ *  \param  s        synthesizer
+ *
+ *  \details The notes of the previous events are released first. Events
+ *           are read until one with a duration.
+ *
+ *  \return void
+ */
+static void next_events(synth_t *s)
+{
+  uint8_t note, ticks;
+
+  release_all(s);
+  while (s->ev && s->wait == 0) {
+    note = pgm_read_byte(s->ev);
+    if (note == SYNTH_END) {
+      if (s->plays && --s->plays == 0) {
+        s->ev = 0;
+      } else {
+        s->ev = s->pattern + SYNTH_HEADER;
+      }
+      break;                            // a pattern without duration cannot loop forever
+    }
+    ticks  = pgm_read_byte(s->ev + 1);
+    s->ev += 2;
+    if (note != SYNTH_REST) note_on(s, note);
+    s->wait = (uint32_t) ticks * s->tick_len;
+  }
+}
+
+/*! \brief  Advance the envelope of a tone by one control step
+ *
+ *  \param  s        synthesizer
+ *  \param  t        tone
+ *
+ *  \return void
+ */
+static void envelope(const synth_t *s, synth_tone_t *t)
+{
+  switch (t->stage) {
+    case STAGE_ATTACK:
+      if (LEVEL_MAX - t->level > s->att) {
+        t->level += s->att;
+        break;
+      }
+      t->level = LEVEL_MAX;
+      t->stage = STAGE_DECAY;
+      break;
+    case STAGE_DECAY:
+      if (t->level > s->sus && t->level - s->sus > s->dec) {
+        t->level -= s->dec;
+        break;
+      }
+      t->level = s->sus;
+      t->stage = STAGE_SUSTAIN;
+      break;
+    case STAGE_RELEASE:
+      if (t->level > s->rel) {
+        t->level -= s->rel;
+        break;
+      }
+      t->level = 0;
+      t->stage = STAGE_OFF;
+      break;
+  }
+}
+
+/*! \brief  Advance the pattern and the envelopes by one control step
+ *
+ *  \param  s        synthesizer
+ *
+ *  \return 1 while the pattern or a tone is still playing, 0 at the end
+ */
+static uint8_t control(synth_t *s)
+{
+  uint8_t i, busy;
+
+  if (s->ev) {
+    if (s->wait > SYNTH_CTRL) {
+      s->wait -= SYNTH_CTRL;
+    } else {
+      s->wait = 0;
+      next_events(s);
+    }
+  }
+
+  busy = s->ev != 0;
+  for (i = 0; i < SYNTH_TONES; i++) {
+    envelope(s, &s->tone[i]);
+    if (s->tone[i].stage != STAGE_OFF) busy = 1;
+  }
+
+  return busy;
+}
+
+/*! \brief  Initialize a synthesizer
+ *
+ *  \param  s        synthesizer
+ *  \param  rate     output rate, at least 4096 Hz (see player_rate())
+ *
+ *  \return void
+ */
+void synth_init(synth_t *s, uint16_t rate)
+{
+  uint8_t i;
+
+  for (i = 0; i < SYNTH_TONES; i++) {
+    s->tone[i].level = 0;
+    s->tone[i].stage = STAGE_OFF;
+  }
+  s->pattern = 0;
+  s->ev      = 0;
+  s->rate    = rate;
+  s->k       = (1UL << 28) / rate;
+  s->ctrl    = 0;
+}
+
+/*! \brief  Start a pattern
+ *
+ *  \param  s        synthesizer
+ *  \param  pattern  pattern in flash, see SYNTH_PATTERN()
+ *
+ *  \details Tones of a previous pattern fade out with their own release.
+ *
+ *  \return void
+ */
+void synth_play(synth_t *s, const uint8_t *pattern)
+{
+  s->pattern  = pattern;
+  s->ev       = pattern + SYNTH_HEADER;
+  s->wait     = 0;
+  s->sus      = (uint16_t) pgm_read_byte(pattern + 3) << 8;
+  s->att      = env_step(s, pgm_read_byte(pattern + 1), LEVEL_MAX);
+  s->dec      = env_step(s, pgm_read_byte(pattern + 2), LEVEL_MAX - s->sus);
+  s->rel      = env_step(s, pgm_read_byte(pattern + 4), LEVEL_MAX);
+  s->tick_len = (uint32_t) pgm_read_byte(pattern + 5) * s->rate / 1000;
+  s->plays    = pgm_read_byte(pattern + 6);
+}
+
+/*! \brief  Stop the pattern; the sounding tones fade out
+ *
+ *  \param  s        synthesizer
+ *
+ *  \return void
+ */
+void synth_stop(synth_t *s)
+{
+  s->ev = 0;
+  release_all(s);
+}
+
+/*! \brief  Mixer source that renders a synthesizer
+ *
+ *  \param  ctx      pointer to a synth_t
+ *  \param  dst      pointer to store the 12-bit DAC codes
+ *  \param  n        number of samples wanted
+ *
+ *  \return number of samples made, less than n when the pattern has ended
+ *          and all tones are silent
+ */
+uint16_t synth_source(void *ctx, uint16_t *dst, uint16_t n)
+{
+  synth_t       *s = ctx;
+  synth_tone_t  *t;
+  const int8_t  *w;
+  uint32_t       ph, inc;
+  uint16_t       got = 0, m, i;
+  int16_t        v;
+  uint8_t        j, lv;
+
+  while (got < n) {
+    if (s->ctrl == 0) {
+      if ( !control(s) ) break;
+      s->ctrl = SYNTH_CTRL;
+    }
+    m = n - got < s->ctrl ? n - got : s->ctrl;
+
+    CYCLES_BEGIN(c);
+    for (i = 0; i < m; i++) dst[i] = 0;
+    for (j = 0; j < SYNTH_TONES; j++) {
+      t  = &s->tone[j];
+      lv = t->level >> 8;
+      if (lv == 0) continue;
+      w   = t->wave;
+      ph  = t->phase;
+      inc = t->inc;
+      for (i = 0; i < m; i++) {
+        dst[i] += ((int8_t) pgm_read_byte(w + (uint8_t) (ph >> 24)) * lv) >> 6;
+        ph     += inc;
+      }
+      t->phase = ph;
+    }
+    for (i = 0; i < m; i++) {
+      v = GAIN_MID + (int16_t) dst[i];
+      dst[i] = v < 0 ? 0 : v > 4095 ? 4095 : v;
+    }
+    CYCLES_END(synth_load, c);
+
+    dst     += m;
+    got     += m;
+    s->ctrl -= m;
+  }
+  synth_samples += got;
+
+  return got;
+}
+
+/*! \brief  Get the cycles spent in synth_source()
+ *
+ *  \param  load     pointer to store the measurement
+ *  \param  samples  pointer to store the number of samples made
+ *
+ *  \details The cycles per sample are load->total / *samples; one run is
+ *           at most SYNTH_CTRL samples. Only measured when AUDIO_PROFILE
+ *           is 1.
+ *
+ *  \return void
+ */
+void synth_get_load(cycles_t *load, uint32_t *samples)
+{
+  cycles_get(&synth_load, load);
+  *samples = synth_samples;
+}
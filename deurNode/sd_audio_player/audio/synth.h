@@ -0,0 +1,118 @@
+/*!
+ *  \file    synth.h
+ *  \brief   Wavetable tone synthesizer for chimes, beeps and alarms
+ *
+ *  \details A synthesizer plays a pattern from flash with up to SYNTH_TONES
+ *           tones at the same time. Every tone reads a wavetable of 256
+ *           samples in flash with a 32-bit phase accumulator and is shaped
+ *           by an ADSR envelope. There is no floating point and no SD-card
+ *           access; synth_source() is a mixer source (mixer.h), so a
+ *           pattern is started with
+ *           <code>player_mix(synth_source, &synth, gain)</code>.
+ *
+ *           A pattern is a byte string in flash: a header made with
+ *           SYNTH_PATTERN() followed by pairs of a note and a duration in
+ *           ticks, ended by SYNTH_END. A note sounds until the next note
+ *           with a duration starts; a note with duration 0 starts together
+ *           with the next one, for chords. SYNTH_REST is a pause. Example,
+ *           a two-tone door chime played once:
+ *           <pre>
+ *           const uint8_t ding_dong[] PROGMEM = {
+ *             SYNTH_PATTERN(SYNTH_BELL, 0, 60, 0, 40, 10, 1),
+ *             SYNTH_NOTE(E, 5), 50, SYNTH_NOTE(C, 5), 100, SYNTH_END
+ *           };
+ *           </pre>
+ *
+ *           The envelope and the pattern advance every SYNTH_CTRL samples.
+ *           With AUDIO_PROFILE set to 1 the cycles in synth_source() are
+ *           measured, see synth_get_load().
+ */
+#ifndef SYNTH_H_
+#define SYNTH_H_
+
+#include <stdint.h>
+#include "cycles.h"
+
+#ifndef SYNTH_TONES
+#define SYNTH_TONES     4       //!< tones of a synthesizer that sound at the same time
+#endif
+#define SYNTH_CTRL      16      //!< samples per step of the envelopes and the pattern
+
+#define SYNTH_SINE      0       //!< wave: sine
+#define SYNTH_TRIANGLE  1       //!< wave: triangle
+#define SYNTH_SQUARE    2       //!< wave: square, 7 harmonics
+#define SYNTH_SAW       3       //!< wave: sawtooth, 8 harmonics
+#define SYNTH_BELL      4       //!< wave: sine with 2nd, 3rd and 5th harmonic
+#define SYNTH_WAVES     5
+
+#define SYNTH_MS_UNIT   8       //!< unit of the envelope times in a pattern header, ms
+#define SYNTH_HEADER    7       //!< bytes of a pattern header
+
+#define SYNTH_REST      0       //!< pattern note: pause
+#define SYNTH_END       0xFF    //!< pattern end
+
+#define SYNTH_C         0       //!< note names for SYNTH_NOTE()
+#define SYNTH_Cs        1
+#define SYNTH_D         2
+#define SYNTH_Ds        3
+#define SYNTH_E         4
+#define SYNTH_F         5
+#define SYNTH_Fs        6
+#define SYNTH_G         7
+#define SYNTH_Gs        8
+#define SYNTH_A         9
+#define SYNTH_As        10
+#define SYNTH_B         11
+
+/*! \brief  MIDI number of a note, octave 0 .. 8 (A4 is 440 Hz) */
+#define SYNTH_NOTE(name, octave)    ( ((octave) + 1) * 12 + SYNTH_##name )
+
+/*! \brief  Pattern header
+ *
+ *  \param  wave     SYNTH_SINE .. SYNTH_BELL
+ *  \param  attack   rise to full level, units of SYNTH_MS_UNIT
+ *  \param  decay    fall to the sustain level, units of SYNTH_MS_UNIT
+ *  \param  sustain  level while the note sounds, 0 .. 255
+ *  \param  release  fall from full level to silence after the note,
+ *                   units of SYNTH_MS_UNIT
+ *  \param  tick     ms per unit of the note durations, 1 .. 255
+ *  \param  repeat   times the pattern is played, 0: until synth_stop()
+ */
+#define SYNTH_PATTERN(wave, attack, decay, sustain, release, tick, repeat) \
+  (wave), (attack), (decay), (sustain), (release), (tick), (repeat)
+
+/*! \brief  One tone */
+typedef struct {
+  uint32_t      phase;          //!< position in the wavetable, 8.24
+  uint32_t      inc;            //!< phase step per sample
+  const int8_t *wave;           //!< wavetable in flash
+  uint16_t      level;          //!< envelope, 8.8, 0 .. 0xFF00
+  uint8_t       stage;          //!< envelope stage
+} synth_tone_t;
+
+/*! \brief  Synthesizer state */
+typedef struct {
+  synth_tone_t   tone[SYNTH_TONES];
+  const uint8_t *pattern;       //!< pattern in flash
+  const uint8_t *ev;            //!< next event of the pattern, 0: pattern done
+  uint32_t       wait;          //!< samples until the next event
+  uint16_t       rate;          //!< output rate
+  uint16_t       k;             //!< 2^28 / rate, phase step per 1/16 Hz
+  uint16_t       tick_len;      //!< samples per tick of the pattern
+  uint16_t       att, dec, rel; //!< envelope steps per SYNTH_CTRL samples
+  uint16_t       sus;           //!< sustain level, 8.8
+  uint8_t        plays;         //!< times the pattern is still played, 0: forever
+  uint8_t        ctrl;          //!< samples until the next control step
+} synth_t;
+
+extern const uint8_t synth_chime[];     //!< door chime, played once
+extern const uint8_t synth_beep[];      //!< short beep
+extern const uint8_t synth_alarm[];     //!< two-tone alarm, until synth_stop()
+
+void     synth_init(synth_t *s, uint16_t rate);
+void     synth_play(synth_t *s, const uint8_t *pattern);
+void     synth_stop(synth_t *s);
+uint16_t synth_source(void *ctx, uint16_t *dst, uint16_t n);
+void     synth_get_load(cycles_t *load, uint32_t *samples);
+
+#endif // SYNTH_H_
@@ -0,0 +1,170 @@
+/*!
+ *  \file    wav.c
+ *  \brief   WAV file header
+ *
+ *  \details The chunks are parsed in place in the sector window of FatFs
+ *           (the window of the volume with FF_FS_TINY, the buffer of the
+ *           file otherwise): a read of one byte loads the sector and the
+ *           fields are taken from the window. Only fields that cross a
+ *           sector boundary are copied. Usually all chunks before the data
+ *           are in the first sector, so the header costs one sector read.
+ */
+#include "wav.h"
+
+#include <string.h>
+
+#define WAV_COPY    52          //!< largest part of a chunk that is parsed: smpl up to the first loop
+
+#if FF_FS_TINY
+#define WINDOW(fp)  ((fp)->obj.fs->win)
+#else
+#define WINDOW(fp)  ((fp)->buf)
+#endif
+
+static uint16_t get16(const uint8_t *p) { return p[0] | p[1] << 8; }
+static uint32_t get32(const uint8_t *p) { return get16(p) | (uint32_t) get16(p + 2) << 16; }
+
+/*! \brief  Get bytes of a file in place
+ *
+ *  \param  fp       file
+ *  \param  pos      file offset
+ *  \param  len      number of bytes, at most WAV_COPY
+ *  \param  copy     buffer of WAV_COPY bytes, used if the bytes cross a
+ *                   sector boundary
+ *  \param  res      pointer to store the result
+ *
+ *  \details The pointer is valid until the next FatFs call.
+ *
+ *  \return pointer to the bytes, 0 past the end of the file or on an error
+ */
+static const uint8_t *window(FIL *fp, FSIZE_t pos, uint8_t len, uint8_t *copy, FRESULT *res)
+{
+  uint16_t ofs = pos % FF_MAX_SS;
+  UINT     br;
+
+  if (pos + len > f_size(fp)) {
+    *res = FR_INVALID_PARAMETER;
+    return 0;
+  }
+  if ( (*res = f_lseek(fp, pos)) != FR_OK ) {
+    return 0;
+  }
+  if (ofs + len > FF_MAX_SS) {
+    *res = f_read(fp, copy, len, &br);
+    return *res == FR_OK ? copy : 0;
+  }
+  if ( (*res = f_read(fp, copy, 1, &br)) != FR_OK ) {     // loads the sector
+    return 0;
+  }
+
+  return WINDOW(fp) + ofs;
+}
+
+/*! \brief  Read the format from a "fmt " chunk
+ *
+ *  \param  p        chunk data
+ *  \param  size     size of the chunk data, at least 16
+ *  \param  info     pointer to store the format
+ *
+ *  \details For WAVE_FORMAT_EXTENSIBLE the format tag is taken from the
+ *           first two bytes of the sub format GUID.
+ *
+ *  \return void
+ */
+static void parse_fmt(const uint8_t *p, uint32_t size, wav_info_t *info)
+{
+  info->format      = get16(p);
+  info->channels    = get16(p + 2);
+  info->sample_rate = get32(p + 4);
+  info->block_align = get16(p + 12);
+  info->bits        = get16(p + 14);
+  if (info->format == WAV_FORMAT_EXTENSIBLE && size >= 40) {
+    info->format = get16(p + 24);
+  }
+}
+
+/*! \brief  Read the first loop from a "smpl" chunk
+ *
+ *  \param  p        chunk data
+ *  \param  size     size of the chunk data
+ *  \param  info     pointer to store the loop
+ *
+ *  \return void
+ */
+static void parse_smpl(const uint8_t *p, uint32_t size, wav_info_t *info)
+{
+  if (size >= WAV_COPY && get32(p + 28) > 0) {
+    info->loop_start = get32(p + 44);
+    info->loop_end   = get32(p + 48) + 1;   // the end in the file is inclusive
+  }
+}
+
+/*! \brief  Read the header of an open WAV file
+ *
+ *  \param  fp       file, opened for reading
+ *  \param  info     pointer to store the format of the audio data
+ *
+ *  \details The chunks are walked in any order until the "data" chunk
+ *           after the "fmt " chunk. "fmt " (also WAVE_FORMAT_EXTENSIBLE) and
+ *           "smpl" are parsed; "LIST", "fact" and other chunks are skipped,
+ *           so metadata is never played as audio. Chunks after the data are
+ *           not read. data_offset and data_size are the exact place of the
+ *           samples; a data chunk that is longer than the file is cut at
+ *           the end of the file. On success the read pointer is at the
+ *           first sample.
+ *
+ *  \return FR_OK, FR_INVALID_PARAMETER if it is not a WAV file or the
+ *          FatFs error code
+ */
+FRESULT wav_read_header(FIL *fp, wav_info_t *info)
+{
+  uint8_t        copy[WAV_COPY];
+  const uint8_t *p;
+  FRESULT        res;
+  FSIZE_t        pos = 12, end;
+  uint32_t       size;
+  uint8_t        fmt = 0, data = 0;
+
+  memset(info, 0, sizeof(*info));
+  if ( !(p = window(fp, 0, 12, copy, &res)) ) {
+    return res;
+  }
+  if ( strncmp((const char *) p, "RIFF", 4) || strncmp((const char *) p + 8, "WAVE", 4) ) {
+    return FR_INVALID_PARAMETER;
+  }
+  end = get32(p + 4);
+  end = end > f_size(fp) - 8 ? f_size(fp) : end + 8;   // RIFF size may be too large
+
+  while ( !(fmt && data) && pos + 8 <= end ) {
+    if ( !(p = window(fp, pos, 8, copy, &res)) ) {
+      return res;
+    }
+    size = get32(p + 4);
+    pos += 8;
+    if (size > end - pos) size = end - pos;          // cut at the end of the file
+
+    if (strncmp((const char *) p, "fmt ", 4) == 0) {
+      if (size < 16) return FR_INVALID_PARAMETER;
+      if ( !(p = window(fp, pos, size < 40 ? 16 : 40, copy, &res)) ) {
+        return res;
+      }
+      parse_fmt(p, size, info);
+      fmt = 1;
+    } else if (strncmp((const char *) p, "data", 4) == 0) {
+      info->data_offset = pos;
+      info->data_size   = size;
+      data = 1;
+    } else if (strncmp((const char *) p, "smpl", 4) == 0 && size >= WAV_COPY) {
+      if ( !(p = window(fp, pos, WAV_COPY, copy, &res)) ) {
+        return res;
+      }
+      parse_smpl(p, size, info);
+    }                                   // LIST, fact, ...: metadata, skipped
+    pos += size + (size & 1);           // chunks are padded to even size
+  }
+  if ( !(fmt && data) ) {
+    return FR_INVALID_PARAMETER;
+  }
+
+  return f_lseek(fp, info->data_offset);
+}
@@ -0,0 +1,51 @@
+/*!
+ *  \file    wav.h
+ *  \brief   WAV file header
+ *
+ *  \details wav_read_header() walks the RIFF chunks of a file. WAVHeader
+ *           is only the canonical 44-byte layout, with "fmt " as the first
+ *           chunk of 16 bytes and "data" right after it; many files have
+ *           other chunks (LIST, fact, smpl) in between.
+ */
+#ifndef WAV_H_
+#define WAV_H_
+
+#include <stdint.h>
+#include "../ff/ff.h"
+
+typedef struct {
+    char riff[4];       // "RIFF"
+    uint32_t size;      // Bestandsgrootte - 8
+    char wave[4];       // "WAVE"
+    char fmt[4];        // "fmt "
+    uint32_t fmt_size;  // Formaatgegevens grootte
+    uint16_t audio_fmt; // Audio type (1 = PCM)
+    uint16_t channels;  // Aantal kanalen
+    uint32_t sample_rate; // Sample rate (bv. 44100 Hz)
+    uint32_t byte_rate;   // Bytes per seconde
+    uint16_t block_align; // Bytes per sample
+    uint16_t bits_per_sample; // 8 of 16 bits
+    char data[4];       // "data"
+    uint32_t data_size; // Aantal data bytes
+} WAVHeader;
+
+/*! \brief  Format of the audio data in a WAV file */
+typedef struct {
+  uint16_t format;              //!< format tag (1 = PCM)
+  uint16_t channels;            //!< number of channels
+  uint32_t sample_rate;         //!< samples per second
+  uint16_t block_align;         //!< bytes per sample frame
+  uint16_t bits;                //!< bits per sample
+  uint32_t data_offset;         //!< file offset of the first sample
+  uint32_t data_size;           //!< number of data bytes
+  uint32_t loop_start;          //!< first frame of the loop in the "smpl" chunk
+  uint32_t loop_end;            //!< frame after the loop, 0: no loop
+} wav_info_t;
+
+#define WAV_FORMAT_PCM        1      //!< format tag of uncompressed PCM
+#define WAV_FORMAT_IMA_ADPCM  0x11   //!< format tag of IMA/DVI ADPCM
+#define WAV_FORMAT_EXTENSIBLE 0xFFFE //!< format tag of WAVE_FORMAT_EXTENSIBLE, the real tag is in the sub format
+
+FRESULT wav_read_header(FIL *fp, wav_info_t *info);
+
+#endif // WAV_H_
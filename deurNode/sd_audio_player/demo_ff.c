@@ -7,11 +7,16 @@
 #include <stdio.h>
 #include "ff/ff.h"
 #include <avr/io.h>
-#include <math.h>
 #include <avr/interrupt.h>
 #include "clock/clock.h"
 #include "serialF0/serialF0.h"
 #include <util/delay.h>
+#include "audio/wav.h"
+#include "audio/sampleclock.h"
+#include "audio/player.h"
+#include "audio/dac.h"
+#include "audio/synth.h"
+#include "audio/pcm.h"
 
 #define F_CPU 32000000UL
 
@@ -73,72 +78,79 @@ int demo_ff(void)
   return FR_OK;
 }
 
-typedef struct {
-    char riff[4];       // "RIFF"
-    uint32_t size;      // Bestandsgrootte - 8
-    char wave[4];       // "WAVE"
-    char fmt[4];        // "fmt "
-    uint32_t fmt_size;  // Formaatgegevens grootte
-    uint16_t audio_fmt; // Audio type (1 = PCM)
-    uint16_t channels;  // Aantal kanalen
-    uint32_t sample_rate; // Sample rate (bv. 44100 Hz)
-    uint32_t byte_rate;   // Bytes per seconde
-    uint16_t block_align; // Bytes per sample
-    uint16_t bits_per_sample; // 8 of 16 bits
-    uint16_t sub_chunk2id;
-    uint16_t subchunk2_size;
-} WAVHeader;
-
-WAVHeader header;
-
 int read_wav_header(const char *filename) {
+    wav_info_t info;
+
     if (f_open(&Fil, filename, FA_READ) != FR_OK) {
         printf("Kan bestand niet openen!\n");
         return 0;
     }
 
-    f_read(&Fil, &header, sizeof(WAVHeader), &br);
-    if (br != sizeof(WAVHeader)) {
-        printf("Fout bij lezen header!\n");
-        f_close(&Fil);
-        return 0;
-    }
-
-    // Controleer of het een geldig WAV-bestand is
-    if (strncmp(header.riff, "RIFF", 4) || strncmp(header.wave, "WAVE", 4)) {
+    // Loopt alle chunks af, ook met LIST/fact/smpl voor de data
+    if (wav_read_header(&Fil, &info) != FR_OK) {
         printf("Geen geldig WAV-bestand!\n");
         f_close(&Fil);
         return 0;
     }
 
-    printf("Sample Rate: %d Hz\n", header.sample_rate);
-    printf("Bits per sample: %d\n", header.bits_per_sample);
-    printf("Kanalen: %d\n", header.channels);
-    printf("Data size: %d\n", header.subchunk2_size);
+    printf("Sample Rate: %lu Hz\n", info.sample_rate);
+    printf("Bits per sample: %u\n", info.bits);
+    printf("Kanalen: %u\n", info.channels);
+    printf("Data: %lu bytes vanaf %lu\n", info.data_size, info.data_offset);
+    if (info.loop_end) {
+        printf("Loop: %lu .. %lu\n", info.loop_start, info.loop_end);
+    }
+    f_close(&Fil);
 
     return 1;
 }
 
 
 
+/*! \brief  Play audio.wav without interrupts. TCC0 is polled for the sample timing,
+ *          so the TCC0 overflow interrupt must be off.
+ *
+ *  \details Only the data chunk is played, decoded by the PCM kernel for the
+ *           format of the file (8 or 16 bit, mono or stereo).
+ */
 void play_wav()
 {
   FIL file;
-  WAVHeader header;
+  wav_info_t info;
+  pcm_decoder_t dec;
   UINT br;
+  uint32_t left;
   uint8_t buffer[512];
+  uint16_t codes[512];
 
   if (f_open(&file, "audio.wav", FA_READ) == FR_OK)
   {
-    f_read(&file, &header, sizeof(WAVHeader), &br); // Lees header
-    while (f_read(&file, buffer, sizeof(buffer), &br) == FR_OK && br > 0)
+    if (wav_read_header(&file, &info) != FR_OK || !pcm_select(&dec, &info) ||
+        !sampleclock_set(info.sample_rate))  // Lees header
+    {
+      printf("Geen geldig WAV-bestand!\n");
+      f_close(&file);
+      return;
+    }
+    left = info.data_size - info.data_size % dec.frame_size;  // alleen hele frames
+    TCC0.INTFLAGS = TC0_OVFIF_bm;
+    TCC0.CTRLA = TC_CLKSEL_DIV1_gc;
+    while (left > 0 &&
+           f_read(&file, buffer, left < sizeof(buffer) ? left : sizeof(buffer), &br) == FR_OK &&
+           br >= dec.frame_size)
     {
-      for (uint16_t i = 0; i < br; i++)
+      left -= br;
+      pcm_decode(&dec, buffer, codes, br / dec.frame_size);
+      for (uint16_t i = 0; i < br / dec.frame_size; i++)
       {
-        DACB.CH0DATA = buffer[i];                // Stuur naar DAC
-        _delay_ms(1000000 / header.sample_rate); // Sample rate timing
+        while (!(TCC0.INTFLAGS & TC0_OVFIF_bm))  // Sample rate timing
+          ;
+        TCC0.INTFLAGS = TC0_OVFIF_bm;
+        sampleclock_step();
+        DACB.CH0DATA = codes[i];                 // Stuur naar DAC
       }
     }
+    TCC0.CTRLA = TC_CLKSEL_OFF_gc;
     f_close(&file);
   }
   else
@@ -146,15 +158,27 @@ void play_wav()
     printf("Kan WAV-bestand niet openen!\n");
   }
 }
-// void play_sound()
-// {
-//   uint16_t i;
-//   while (1)
-//   {
-//     for (i = 0; i < 256; i++)
-//     {
-//       DACB.CH0DATA = 2048 + (1024 * sin(i * 2 * 3.14159 / 256)); // Sinusgolf
-//       _delay_ms(4);
-//     }
-//   }
-// }
+/*! \brief  Play the door chime with the synthesizer, without the SD-card
+ *
+ *  \details The output must be initialized with init_dac() and
+ *           timer_init(). The chime is rendered by synth.c into the player
+ *           ring; no floating point and no busy waiting per sample.
+ *
+ *  \return void
+ */
+void play_sound()
+{
+  static synth_t synth;
+
+  synth_init(&synth, player_rate());
+  synth_play(&synth, synth_chime);
+  if (player_mix(synth_source, &synth, MIXER_UNITY) == MIXER_NONE)
+  {
+    return;
+  }
+  sampleclock_set(player_rate());
+  dac_start();
+  while (player_service())          // vul vrije buffers bij
+    ;
+  dac_stop();
+}
@@ -42,6 +42,13 @@ extern "C" {
     void*	data;	/* Pointer to the data (to be written | read buffer) */
   } SDIO_CTRL;
 
+  /* SPI counters of sdmm.c (MMC_GET_SPI_STAT) */
+  typedef struct {
+    DWORD	bytes;	/* Bytes clocked through the SPI */
+    DWORD	data;	/* Bytes of those in data blocks */
+    DWORD	cmds;	/* Commands sent to the card */
+  } MMC_SPI_STAT;
+
 
   /*---------------------------------------*/
   /* Prototypes for disk control functions */
@@ -50,9 +57,14 @@ extern "C" {
   DSTATUS disk_initialize (BYTE pdrv);
   DSTATUS disk_status (BYTE pdrv);
   DRESULT disk_read (BYTE pdrv, BYTE* buff, LBA_t sector, UINT count);
+  DRESULT disk_read_dma (BYTE pdrv, BYTE* buff, LBA_t sector, void (*done)(DRESULT res));
   DRESULT disk_write (BYTE pdrv, const BYTE* buff, LBA_t sector, UINT count);
   DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
+  DRESULT disk_read_async (BYTE pdrv, BYTE* buff, LBA_t sector, UINT count, void (*done)(DRESULT res));
+  DRESULT disk_write_async (BYTE pdrv, const BYTE* buff, LBA_t sector, UINT count, void (*done)(DRESULT res));
+  int disk_async_poll (void);
   void disk_timerproc (void);
+  void disk_set_yield (void (*func)(void));
 
 
   /* Disk Status Bits (DSTATUS) */
@@ -89,6 +101,13 @@ extern "C" {
   #define ISDIO_WRITE			56	/* Write data to SD iSDIO register */
   #define ISDIO_MRITE			57	/* Masked write data to SD iSDIO register */
 
+  /* sdmm.c specific command (Not used by FatFs) */
+  #define MMC_STOP_READ		70	/* Stop an open multiple block read and release the card */
+  #define MMC_GET_SPI_STAT	71	/* Get the SPI counters (MMC_SPI_STAT) */
+  #define MMC_RCVR_LOOP		72	/* Receive 512 bytes with the byte loop, card deselected (timing) */
+  #define MMC_RCVR_FAST		73	/* Receive 512 bytes with the sector loop, card deselected (timing) */
+  #define MMC_GET_SPI_CLOCK	74	/* Get the SPI clock in Hz (DWORD), set from TRAN_SPEED of the CSD */
+
   /* ATA/CF specific command (Not used by FatFs) */
   #define ATA_GET_REV			60	/* Get F/W revision */
   #define ATA_GET_MODEL		61	/* Get model name */
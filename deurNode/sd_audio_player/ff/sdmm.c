@@ -9,7 +9,8 @@
  *             The most important global changes are:
  *             - It is suitable for the ATxmega256a3u.
  *             - It uses the Xmega style (DIRSET, OUTSET, ...).
- *             - It uses SPIC with a remap of (SCK and MOSI) in stead of bit banging.
+ *             - It uses SPIC with a remap of (SCK and MOSI) in stead of bit banging
+ *               (or USARTC1 in master SPI mode on the same pins, see change 12).
  *             .
  *  
  *             The most important detailed changes are:
@@ -25,6 +26,53 @@
  *                 It now uses sdspi_read_byte() to read bytes
  *             7.  The function disk_initialize() is changed.
  *                 It now uses the function sdspi_init() to initialize the SPI.
+ *             8.  The function disk_read() is changed. It keeps one READ_MULTIPLE_BLOCK
+ *                 (CMD18) open across calls as long as the next call reads the next
+ *                 sector, so sequential reads need no command, select and wait_ready()
+ *                 per call. The read is stopped (CMD12) by a read of another sector,
+ *                 by disk_write(), by disk_ioctl() and by disk_initialize(). The
+ *                 queries GET_BLOCK_SIZE, MMC_GET_SPI_STAT and MMC_GET_SPI_CLOCK do
+ *                 not use the card and leave the read open.
+ *                 The card stays selected while the read is open: stop it with
+ *                 disk_ioctl(drv, MMC_STOP_READ, 0) before SPIC is used for another device.
+ *             9.  The SPI bytes, the data bytes and the commands are counted, see
+ *                 disk_ioctl(drv, MMC_GET_SPI_STAT, &stat) with a MMC_SPI_STAT.
+ *             10. With SD_DMA 1 the data phase of rcvr_datablock() and xmit_datablock()
+ *                 is done by DMA channels 2 and 3 paired with SPIC (rcvr_mmc_block() and
+ *                 xmit_mmc_block()); the CPU waits for the end of the block.
+ *                 disk_read_dma() reads one sector and returns as soon as the data block
+ *                 streams in; a callback is called from the DMA interrupt (low level)
+ *                 when it is complete. Until then the other functions wait.
+ *                 Channels 0 and 1 are left to the audio output (audio/dac.c); call
+ *                 timer_init() before disk_initialize(), because it resets the DMA controller.
+ *             11. With SD_DMA 0 the data blocks are received by rcvr_mmc_fast(), an unrolled
+ *                 loop that starts the next byte as soon as the previous one is read.
+ *                 disk_ioctl(drv, MMC_RCVR_LOOP, buf) and disk_ioctl(drv, MMC_RCVR_FAST, buf)
+ *                 receive 512 bytes in buf with the old and the new loop while the card is
+ *                 deselected, to count the cycles per sector (no card needed).
+ *             12. With SD_USART 1 the card is driven by USARTC1 in master SPI mode instead
+ *                 of SPIC, on the same pins and at the same clocks. Its transmit
+ *                 buffer lets xmit_mmc() and rcvr_mmc() send the next byte without a gap.
+ *                 DMA is not used with SD_USART 1 (SD_DMA 0).
+ *             13. The card is initialized at 400 kHz or less (SPIC: fcpu/128). Then
+ *                 disk_initialize() reads TRAN_SPEED from the CSD and sets the fastest
+ *                 clock that the card and the MCU allow, up to fcpu/2 (16 MHz, SPIC with
+ *                 CLK2X) or SD_SPI_MAX. See disk_ioctl(drv, MMC_GET_SPI_CLOCK, &hz).
+ *             14. The timeouts of wait_ready(), wait_token() and disk_initialize() are
+ *                 deadlines in ticks of disk_timerproc() instead of dly_us() loops.
+ *                 With SD_TICK 1 the overflow interrupt of TCE0 (low level) calls it
+ *                 every 1 ms; before sei() the overflow flag is polled instead. With
+ *                 SD_TICK 0 the application must call disk_timerproc() every 1 ms.
+ *                 While it waits, the driver calls the hook of disk_set_yield(); the
+ *                 hook must not use the card or SPIC.
+ *             15. disk_read_async() and disk_write_async() only send the command and
+ *                 return. disk_async_poll(), called from the main loop, advances them: it
+ *                 polls for the data token or the end of the busy time once per call and
+ *                 moves a block when the card is ready; with SD_DMA 1 a read block is
+ *                 received by DMA in the background. A callback is called from
+ *                 disk_async_poll() at the end. A write is complete when the card is no
+ *                 longer busy. The card stays selected meanwhile; the other functions
+ *                 finish a running transfer first.
  *
  *  \note      It is beter to use a 32 MHz clock.
  *             The error in the delays will be relatively large at a low frequency
@@ -75,6 +123,7 @@
 #endif
 #include <avr/io.h>      /* Include device specific declaration file here */
 #include <util/delay.h>                                                        //!< added:  This implementation uses the delay functions
+#include <avr/interrupt.h>                                                     //!< added:  for the DMA and tick interrupts
 
 static void dly_us (uint16_t n) {
   for (uint16_t i=0; i<n/10; i++) {
@@ -83,6 +132,22 @@ static void dly_us (uint16_t n) {
 }
 
 #define CS_H sdspi_CShigh                                                      //!< added:  alias for sdspi_CShigh
+#ifndef SD_USART
+#define SD_USART 0                                                             //!< added:  1: USARTC1 in master SPI mode instead of SPIC
+#endif
+#ifndef SD_DMA
+#define SD_DMA (!SD_USART)                                                     //!< added:  1: data blocks are moved by DMA channels 2 and 3
+#endif
+#if SD_DMA && SD_USART
+#error "SD_DMA is paired with SPIC, use SD_DMA 0 with SD_USART 1"
+#endif
+#ifndef SD_SPI_MAX
+#define SD_SPI_MAX (F_CPU / 2)                                                 //!< added:  highest SPI clock (Hz) after the initialization
+#endif
+#define SD_SPI_INIT 400000UL                                                   //!< added:  highest SPI clock (Hz) during the initialization
+#ifndef SD_TICK
+#define SD_TICK 1                                                              //!< added:  1: TCE0 calls disk_timerproc() every 1 ms
+#endif
 #define CS_L sdspi_CSlow                                                       //!< added:  alias for sdspi_CSlow
 
 //! \endcond 
@@ -120,6 +185,18 @@ static void dly_us (uint16_t n) {
 static DSTATUS Stat = STA_NOINIT;  // Disk status
 static BYTE CardType;              // b0:MMC, b1:SDv1, b2:SDv2,
                                    //       b3:Block addressing
+static BYTE ReadOpen;              //!< added:  1: a READ_MULTIPLE_BLOCK is open
+static DWORD ReadNext;             //!< added:  sector (LBA) of the next block of the open read
+static MMC_SPI_STAT SpiStat;       //!< added:  SPI byte and command counters
+static DWORD SpiClock;             //!< added:  SPI clock (Hz)
+static volatile WORD Tick;         //!< added:  1 ms ticks counted by disk_timerproc()
+static void (*Yield)(void);        //!< added:  called while waiting for the card
+static BYTE AsyncState;            //!< added:  step of disk_read_async() and disk_write_async()
+static BYTE *AsyncBuff;            //!< added:  data of the next block
+static UINT AsyncCount;            //!< added:  blocks still to be moved
+static BYTE AsyncToken;            //!< added:  0xFE: single block write, 0xFC: multiple block write
+static WORD AsyncEnd;              //!< added:  deadline of the current wait
+static void (*AsyncDone)(DRESULT res);  //!< added:  completion callback
 
 //! \endcond 
 
@@ -130,6 +207,100 @@ static BYTE CardType;              // b0:MMC, b1:SDv1, b2:SDv2,
 #define sdspi_CSlow()   PORTC.OUTCLR = PIN4_bm           //!< added:  define for Chip Select low  
 #define sdspi_CShigh()  PORTC.OUTSET = PIN4_bm           //!< added:  define for Chip Select high
 
+#if SD_TICK
+/*-----------------------------------------------------------------------*/
+/* 1 ms tick for SD-card HvA-Xmegaboard version 2                        */
+/*-----------------------------------------------------------------------*/
+static void sdtick_init(void)
+{
+  if (TCE0.CTRLA != TC_CLKSEL_OFF_gc) return;   // already running
+
+  TCE0.CTRLB    = TC_WGMODE_NORMAL_gc;
+  TCE0.PER      = F_CPU / 1000 - 1;
+  TCE0.INTCTRLA = TC_OVFINTLVL_LO_gc;
+  PMIC.CTRL    |= PMIC_LOLVLEN_bm;
+  TCE0.CTRLA    = TC_CLKSEL_DIV1_gc;
+}
+
+ISR(TCE0_OVF_vect)
+{
+  disk_timerproc();
+}
+#endif
+
+/*-----------------------------------------------------------------------*/
+/* Deadline in ticks of disk_timerproc()                                 */
+/*-----------------------------------------------------------------------*/
+//  WORD ms  /* Milliseconds from now */
+static WORD sdtick_deadline(WORD ms)
+{
+  WORD t;
+
+  do t = Tick; while (t != Tick);     // 16 bits, changed by the interrupt
+
+  return t + ms;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Check a deadline                                                      */
+/*-----------------------------------------------------------------------*/
+//  WORD end  /* Deadline from sdtick_deadline() */
+//  Returns 1 before the deadline, 0 when it has passed
+//
+// With interrupts disabled (before sei()) the overflow flag of TCE0 is
+// handled here instead of in the ISR.
+static int sdtick_before(WORD end)
+{
+#if SD_TICK
+  if ( !(SREG & CPU_I_bm) && (TCE0.INTFLAGS & TC0_OVFIF_bm) ) {
+    TCE0.INTFLAGS = TC0_OVFIF_bm;
+    disk_timerproc();
+  }
+#endif
+
+  return (int16_t) (end - sdtick_deadline(0)) > 0;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Poll a deadline                                                       */
+/*-----------------------------------------------------------------------*/
+//  WORD end  /* Deadline from sdtick_deadline() */
+//  Returns 1 before the deadline, 0 when it has passed
+//
+// Calls the yield hook of disk_set_yield().
+static int sdtick_wait(WORD end)
+{
+  if (Yield) Yield();
+
+  return sdtick_before(end);
+}
+
+#if !SD_USART
+/*-----------------------------------------------------------------------*/
+/* SPI clock for SD-card HvA-Xmegaboard version 2                        */
+/*-----------------------------------------------------------------------*/
+//  DWORD max  /* Highest clock allowed (Hz) */
+//  Returns the clock that is set (Hz): the fastest of fcpu/2 .. fcpu/128
+//  that is not above max, fcpu/128 if they all are
+static DWORD sdspi_clock(DWORD max)
+{
+  static const BYTE prescaler[] = {   // fcpu/2, /4, /8, /16, /32, /64, /128
+    SPI_CLK2X_bm | SPI_PRESCALER_DIV4_gc,  SPI_PRESCALER_DIV4_gc,
+    SPI_CLK2X_bm | SPI_PRESCALER_DIV16_gc, SPI_PRESCALER_DIV16_gc,
+    SPI_CLK2X_bm | SPI_PRESCALER_DIV64_gc, SPI_PRESCALER_DIV64_gc,
+    SPI_PRESCALER_DIV128_gc
+  };
+  BYTE n = 0;
+
+  while (n < 6 && (F_CPU / 2 >> n) > max) n++;
+  SPIC.CTRL = SPI_ENABLE_bm |
+              SPI_MASTER_bm |
+              prescaler[n] |
+              SPI_MODE_0_gc;
+
+  return F_CPU / 2 >> n;
+}
+
 /*-----------------------------------------------------------------------*/
 /* SPI Initialization for SD-card HvA-Xmegaboard version 2               */
 /*-----------------------------------------------------------------------*/
@@ -143,11 +314,8 @@ static void sdspi_init(void)
   PORTC.DIRSET   = PIN4_bm;             // chip select output
   PORTC.PIN6CTRL = PORT_OPC_PULLUP_gc;  // MISO        pullup
 
-  // fspi = fcpu/4 = 8 MHz
-  SPIC.CTRL      = SPI_ENABLE_bm |
-                   SPI_MASTER_bm |
-                   SPI_PRESCALER_DIV4_gc |
-                   SPI_MODE_0_gc;
+  // fspi = fcpu/128 = 250 kHz until the card is initialized
+  SpiClock       = sdspi_clock(SD_SPI_INIT);
   SPIC.INTCTRL   = SPI_INTLVL_OFF_gc;
 
   // disable card
@@ -183,6 +351,7 @@ static void xmit_mmc (const BYTE* buff, UINT bc)
 {
   BYTE d;
 
+  SpiStat.bytes += bc;                                                        //!< added:  count the bytes
   do {
     d = *buff++;  /* Get a byte to be sent */
     sdspi_write_byte(d);
@@ -198,11 +367,298 @@ static void rcvr_mmc(BYTE *buff, UINT bc)
 {
   BYTE r;
 
+  SpiStat.bytes += bc;                                                        //!< added:  count the bytes
   do {
     r = sdspi_read_byte();
     *buff++ = r;      /* Store a received byte */
   } while (--bc);
 }
+
+/*-----------------------------------------------------------------------*/
+/* Receive a data block from the card, overlapped (with SPI)             */
+/*-----------------------------------------------------------------------*/
+//  BYTE *buff,  /* Pointer to read buffer */
+//  UINT bc    /* Number of bytes to receive (4..65532, multiple of 4) */
+//
+// The next 0xFF is written as soon as the received byte is read from
+// SPIC.DATA, so between two bytes the SPI only waits for the poll, the load
+// and the store; the byte is saved while the next one is shifted in.
+// Unrolled four times, with rcvr_next() inlined.
+static inline BYTE rcvr_next(void)
+{
+  BYTE d;
+
+  while ( !(SPIC.STATUS & SPI_IF_bm) ) ;
+  d = SPIC.DATA;
+  SPIC.DATA = 0xFF;               // next byte, shifted while d is stored
+
+  return d;
+}
+
+static void rcvr_mmc_fast(BYTE *buff, UINT bc)
+{
+  SpiStat.bytes += bc;
+  SPIC.DATA = 0xFF;               // first byte
+  bc >>= 2;
+  while (--bc) {
+    *buff++ = rcvr_next(); *buff++ = rcvr_next();
+    *buff++ = rcvr_next(); *buff++ = rcvr_next();
+  }
+  *buff++ = rcvr_next(); *buff++ = rcvr_next(); *buff++ = rcvr_next();
+  while ( !(SPIC.STATUS & SPI_IF_bm) ) ;
+  *buff = SPIC.DATA;              // last byte, no next transfer
+}
+#else
+/*-----------------------------------------------------------------------*/
+/* USART clock for SD-card HvA-Xmegaboard version 2                      */
+/*-----------------------------------------------------------------------*/
+//  DWORD max  /* Highest clock allowed (Hz) */
+//  Returns the clock that is set (Hz): the fastest fcpu/(2*(BSEL+1))
+//  that is not above max, BSEL 4095 if they all are
+static DWORD sdspi_clock(DWORD max)
+{
+  DWORD bsel = 4095;
+
+  if (max > F_CPU / 2 / 4096) bsel = (F_CPU / 2 + max - 1) / max - 1;
+  USARTC1.BAUDCTRLA = (BYTE) bsel;
+  USARTC1.BAUDCTRLB = (BYTE) (bsel >> 8);
+
+  return F_CPU / 2 / (bsel + 1);
+}
+
+/*-----------------------------------------------------------------------*/
+/* USART Initialization for SD-card HvA-Xmegaboard version 2             */
+/*-----------------------------------------------------------------------*/
+// USARTC1 in master SPI mode is on the same pins as SPIC with the remap:
+// XCK1 (PC5) is SCK, RXD1 (PC6) is MISO and TXD1 (PC7) is MOSI.
+static void sdspi_init(void)
+{
+  // port configuratie mmc/sd/sdhc card
+  PORTC.DIRCLR   = PIN6_bm;             // MISO        input
+  PORTC.OUTCLR   = PIN5_bm;             // SCK         low when idle (mode 0)
+  PORTC.DIRSET   = PIN5_bm;             // SCK         output
+  PORTC.DIRSET   = PIN7_bm;             // MOSI        output
+  PORTC.DIRSET   = PIN4_bm;             // chip select output
+  PORTC.PIN6CTRL = PORT_OPC_PULLUP_gc;  // MISO        pullup
+
+  // fspi = fcpu/(2*(BSEL+1)) = 400 kHz until the card is initialized
+  SPIC.CTRL         = 0;
+  SpiClock          = sdspi_clock(SD_SPI_INIT);
+  USARTC1.CTRLA     = 0;                        // no interrupts
+  USARTC1.CTRLC     = USART_CMODE_MSPI_gc;      // mode 0, MSB first
+  USARTC1.CTRLB     = USART_RXEN_bm | USART_TXEN_bm;
+
+  // disable card
+  sdspi_CShigh();
+}
+
+/*-----------------------------------------------------------------------*/
+/* USART write byte for SD-card HvA-Xmegaboard version 2                 */
+/*-----------------------------------------------------------------------*/
+static void sdspi_write_byte(unsigned char databyte)
+{
+  USARTC1.DATA = databyte;
+  while ( !(USARTC1.STATUS & USART_RXCIF_bm) ) ;
+  (void) USARTC1.DATA;                  // discard the received byte
+}
+
+/*-----------------------------------------------------------------------*/
+/* USART read byte for SD-card HvA-Xmegaboard version 2                  */
+/*-----------------------------------------------------------------------*/
+static unsigned char sdspi_read_byte(void)
+{
+  USARTC1.DATA = 0xff;
+  while ( !(USARTC1.STATUS & USART_RXCIF_bm) ) ;
+
+  return (USARTC1.DATA);
+}
+
+/*-----------------------------------------------------------------------*/
+/* Transmit bytes to the card (with USART)                               */
+/*-----------------------------------------------------------------------*/
+//  const BYTE* buff,  /* Data to be sent */
+//  UINT bc        /* Number of bytes to send */
+//
+// The transmit buffer is written as soon as it is empty, so the next byte
+// follows without a gap. The received bytes are read and discarded on the
+// way; at most one arrives per byte written.
+static void xmit_mmc (const BYTE* buff, UINT bc)
+{
+  UINT rc = bc;                         // bytes still to be received
+
+  SpiStat.bytes += bc;
+  do {
+    while ( !(USARTC1.STATUS & USART_DREIF_bm) ) ;
+    USARTC1.DATA = *buff++;
+    while (USARTC1.STATUS & USART_RXCIF_bm) {
+      (void) USARTC1.DATA;
+      rc--;
+    }
+  } while (--bc);
+  while (rc) {
+    while ( !(USARTC1.STATUS & USART_RXCIF_bm) ) ;
+    (void) USARTC1.DATA;
+    rc--;
+  }
+}
+
+/*-----------------------------------------------------------------------*/
+/* Receive bytes from the card (with USART)                              */
+/*-----------------------------------------------------------------------*/
+//  BYTE *buff,  /* Pointer to read buffer */
+//  UINT bc    /* Number of bytes to receive */
+//
+// Two bytes are kept in flight, one in the shift register and one in the
+// transmit buffer, so the SPI clock runs on while a byte is stored. The
+// receive buffer (two bytes) cannot overflow.
+static void rcvr_mmc(BYTE *buff, UINT bc)
+{
+  UINT tc = bc;                         // bytes still to be sent
+
+  SpiStat.bytes += bc;
+  USARTC1.DATA = 0xFF;
+  tc--;
+  do {
+    if (tc) {
+      while ( !(USARTC1.STATUS & USART_DREIF_bm) ) ;
+      USARTC1.DATA = 0xFF;
+      tc--;
+    }
+    while ( !(USARTC1.STATUS & USART_RXCIF_bm) ) ;
+    *buff++ = USARTC1.DATA;
+  } while (--bc);
+}
+
+// The USART loop is already overlapped
+#define rcvr_mmc_fast rcvr_mmc
+#endif
+
+#if SD_DMA
+static const BYTE DmaOnes = 0xFF;                                             //!< added:  source of the 0xFF bytes sent while receiving
+static BYTE DmaSink;                                                          //!< added:  destination of the bytes received while sending
+static void (*DmaDone)(DRESULT res);                                          //!< added:  callback of disk_read_dma()
+static volatile BYTE DmaBusy;                                                 //!< added:  1: disk_read_dma() transfer running
+
+/*-----------------------------------------------------------------------*/
+/* Set a 24-bit DMA address for SD-card HvA-Xmegaboard version 2         */
+/*-----------------------------------------------------------------------*/
+//  volatile BYTE *reg,  /* SRCADDR0 or DESTADDR0 of a channel */
+//  const volatile void *p  /* Address in the data space */
+static void sdspi_dma_addr(volatile BYTE *reg, const volatile void *p)
+{
+  reg[0] = (BYTE) (uint16_t) p;
+  reg[1] = (BYTE) ((uint16_t) p >> 8);
+  reg[2] = 0;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Start a DMA block transfer for SD-card HvA-Xmegaboard version 2       */
+/*-----------------------------------------------------------------------*/
+//  BYTE *rx,        /* Buffer for the received bytes, 0: discard them */
+//  const BYTE *tx,  /* Bytes to send, 0: send 0xFF */
+//  UINT bc,         /* Number of bytes (2..65535) */
+//  BYTE intlvl      /* Interrupt level of the end of the transfer */
+//
+// SPIC has no transmit buffer, so each transfer complete flag triggers two
+// channels: CH2 stores the received byte and then CH3 (lower priority)
+// writes the next byte. The first byte is written here.
+static void sdspi_dma_start(BYTE *rx, const BYTE *tx, UINT bc, BYTE intlvl)
+{
+  if ( !(DMA.CTRL & DMA_ENABLE_bm) ) {
+    DMA.CTRL = DMA_ENABLE_bm | DMA_PRIMODE_CH0123_gc;  // CH2 before CH3
+  }
+
+  DMA.CH2.ADDRCTRL = DMA_CH_SRCRELOAD_NONE_gc | DMA_CH_SRCDIR_FIXED_gc |
+                     DMA_CH_DESTRELOAD_NONE_gc |
+                     (rx ? DMA_CH_DESTDIR_INC_gc : DMA_CH_DESTDIR_FIXED_gc);
+  DMA.CH2.TRIGSRC  = DMA_CH_TRIGSRC_SPIC_gc;
+  DMA.CH2.TRFCNT   = bc;
+  sdspi_dma_addr(&DMA.CH2.SRCADDR0, &SPIC.DATA);
+  sdspi_dma_addr(&DMA.CH2.DESTADDR0, rx ? rx : &DmaSink);
+  DMA.CH2.CTRLB    = DMA_CH_TRNIF_bm | DMA_CH_ERRIF_bm | intlvl;
+  DMA.CH2.CTRLA    = DMA_CH_ENABLE_bm | DMA_CH_SINGLE_bm | DMA_CH_BURSTLEN_1BYTE_gc;
+
+  DMA.CH3.ADDRCTRL = DMA_CH_SRCRELOAD_NONE_gc |
+                     (tx ? DMA_CH_SRCDIR_INC_gc : DMA_CH_SRCDIR_FIXED_gc) |
+                     DMA_CH_DESTRELOAD_NONE_gc | DMA_CH_DESTDIR_FIXED_gc;
+  DMA.CH3.TRIGSRC  = DMA_CH_TRIGSRC_SPIC_gc;
+  DMA.CH3.TRFCNT   = bc - 1;
+  sdspi_dma_addr(&DMA.CH3.SRCADDR0, tx ? tx + 1 : &DmaOnes);
+  sdspi_dma_addr(&DMA.CH3.DESTADDR0, &SPIC.DATA);
+  DMA.CH3.CTRLB    = DMA_CH_TRNIF_bm | DMA_CH_ERRIF_bm;
+  DMA.CH3.CTRLA    = DMA_CH_ENABLE_bm | DMA_CH_SINGLE_bm | DMA_CH_BURSTLEN_1BYTE_gc;
+
+  SpiStat.bytes += bc;
+  SPIC.DATA = tx ? tx[0] : 0xFF;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Wait for the end of a DMA block transfer                              */
+/*-----------------------------------------------------------------------*/
+static void sdspi_dma_wait(void)
+{
+  while ( !(DMA.CH2.CTRLB & DMA_CH_TRNIF_bm) ) ;
+  DMA.CH2.CTRLB = DMA_CH_TRNIF_bm;
+  DMA.CH3.CTRLB = DMA_CH_TRNIF_bm;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Wait until a disk_read_dma() transfer is complete                     */
+/*-----------------------------------------------------------------------*/
+static void sdspi_dma_idle(void)
+{
+  while (DmaBusy) {
+    if (Yield) Yield();
+  }
+}
+
+/*-----------------------------------------------------------------------*/
+/* End of a disk_read_dma() transfer                                     */
+/*-----------------------------------------------------------------------*/
+ISR(DMA_CH2_vect)
+{
+  BYTE d[2];
+
+  DMA.CH2.CTRLB = DMA_CH_TRNIF_bm;  // interrupt off
+  DMA.CH3.CTRLB = DMA_CH_TRNIF_bm;
+  rcvr_mmc(d, 2);                   // discard CRC
+  DmaBusy = 0;
+  if (DmaDone) DmaDone(RES_OK);
+}
+#else
+static void sdspi_dma_idle(void) { }
+#endif
+
+/*-----------------------------------------------------------------------*/
+/* Transmit a data block to the card (DMA with SD_DMA 1)                 */
+/*-----------------------------------------------------------------------*/
+//  const BYTE* buff,  /* Data to be sent */
+//  UINT bc        /* Number of bytes to send (2..65535) */
+static void xmit_mmc_block (const BYTE* buff, UINT bc)
+{
+#if SD_DMA
+  sdspi_dma_start(0, buff, bc, DMA_CH_TRNINTLVL_OFF_gc);
+  sdspi_dma_wait();
+#else
+  xmit_mmc(buff, bc);
+#endif
+}
+
+/*-----------------------------------------------------------------------*/
+/* Receive a data block from the card (DMA with SD_DMA 1)                */
+/* (the overlapped loop with SD_DMA 0)                                   */
+/*-----------------------------------------------------------------------*/
+//  BYTE *buff,  /* Pointer to read buffer */
+//  UINT bc    /* Number of bytes to receive (4..65532, multiple of 4) */
+static void rcvr_mmc_block(BYTE *buff, UINT bc)
+{
+#if SD_DMA
+  sdspi_dma_start(buff, 0, bc, DMA_CH_TRNINTLVL_OFF_gc);
+  sdspi_dma_wait();
+#else
+  rcvr_mmc_fast(buff, bc);
+#endif
+}
 //! \endcond
 
 //! \cond NOTCHANGED2
@@ -210,7 +666,9 @@ static void rcvr_mmc(BYTE *buff, UINT bc)
  * FROM HERE NOTHING CHANGED!
  * From it is completely equal to sdmm.c of example generic/sdmm.c
  * Except that in function disk_initialize() spi_init() is used to
- * initialize the SPI
+ * initialize the SPI, that the data blocks and commands are counted,
+ * that disk_read() keeps a multiple block read open and that the data
+ * blocks are moved with rcvr_mmc_block() and xmit_mmc_block() (see changes 8 to 11)
  */
 /*-----------------------------------------------------------------------*/
 /* Wait for card ready                                                   */
@@ -218,16 +676,14 @@ static void rcvr_mmc(BYTE *buff, UINT bc)
 static int wait_ready (void)  /* 1:OK, 0:Timeout */
 {
   BYTE d;
-  UINT tmr;
+  WORD end = sdtick_deadline(500);  /* Wait for ready in timeout of 500ms */  //! Changed: tick deadline, see change 14
 
 
-  for (tmr = 5000; tmr; tmr--) {  /* Wait for ready in timeout of 500ms */
+  do
     rcvr_mmc(&d, 1);
-    if (d == 0xFF) break;
-    dly_us(100);
-  }
+  while (d != 0xFF && sdtick_wait(end));
 
-  return tmr ? 1 : 0;
+  return d == 0xFF ? 1 : 0;
 }
 
 /*-----------------------------------------------------------------------*/
@@ -261,6 +717,20 @@ static int select (void)  /* 1:OK, 0:Timeout */
 /* Receive a data packet from the card                                   */
 /*-----------------------------------------------------------------------*/
 
+static
+int wait_token (void)  /* 1:OK, 0:Failed */                                  //!< added:  split from rcvr_datablock()
+{
+  BYTE d;
+  WORD end = sdtick_deadline(100);  /* Wait for data packet in timeout of 100ms */  //! Changed: tick deadline, see change 14
+
+
+  do
+    rcvr_mmc(&d, 1);
+  while (d == 0xFF && sdtick_wait(end));
+
+  return d == 0xFE ? 1 : 0;    /* If not valid data token, return with error */
+}
+
 static
 int rcvr_datablock (  /* 1:OK, 0:Failed */
   BYTE *buff,      /* Data buffer to store received data */
@@ -268,18 +738,13 @@ int rcvr_datablock (  /* 1:OK, 0:Failed */
 )
 {
   BYTE d[2];
-  UINT tmr;
 
 
-  for (tmr = 1000; tmr; tmr--) {  /* Wait for data packet in timeout of 100ms */
-    rcvr_mmc(d, 1);
-    if (d[0] != 0xFF) break;
-    dly_us(100);
-  }
-  if (d[0] != 0xFE) return 0;    /* If not valid data token, return with error */
+  if (!wait_token()) return 0;
 
-  rcvr_mmc(buff, btr);      /* Receive the data block into buffer */
+  rcvr_mmc_block(buff, btr);  /* Receive the data block into buffer */
   rcvr_mmc(d, 2);          /* Discard CRC */
+  SpiStat.data += btr;                                                        //!< added:  count the data bytes
 
   return 1;            /* Return with success */
 }
@@ -304,7 +769,8 @@ int xmit_datablock (  /* 1:OK, 0:Failed */
   d[0] = token;
   xmit_mmc(d, 1);        /* Xmit a token */
   if (token != 0xFD) {    /* Is it data token? */
-    xmit_mmc(buff, 512);  /* Xmit the 512 byte data block to MMC */
+    xmit_mmc_block(buff, 512);  /* Xmit the 512 byte data block to MMC */
+    SpiStat.data += 512;                                                      //!< added:  count the data bytes
     rcvr_mmc(d, 2);      /* Xmit dummy CRC (0xFF,0xFF) */
     rcvr_mmc(d, 1);      /* Receive data response */
     if ((d[0] & 0x1F) != 0x05)  /* If not accepted, return with error */
@@ -342,6 +808,7 @@ BYTE send_cmd (    /* Returns command response (bit7==1:Send failed)*/
   }
 
   /* Send a command packet */
+  SpiStat.cmds++;                                                             //!< added:  count the commands
   buf[0] = 0x40 | cmd;      /* Start + Command index */
   buf[1] = (BYTE)(arg >> 24);    /* Argument[31..24] */
   buf[2] = (BYTE)(arg >> 16);    /* Argument[23..16] */
@@ -365,6 +832,39 @@ BYTE send_cmd (    /* Returns command response (bit7==1:Send failed)*/
 
 
 
+/*-----------------------------------------------------------------------*/
+/* Stop the open multiple block read                                     */
+/*-----------------------------------------------------------------------*/
+
+static void stop_read (void)                                                  //!< added:  see change 8
+{
+  if (ReadOpen) {
+    ReadOpen = 0;
+    send_cmd(CMD12, 0);  /* STOP_TRANSMISSION */
+    deselect();
+  }
+}
+
+/*-----------------------------------------------------------------------*/
+/* Open a multiple block read or continue the open one                   */
+/*-----------------------------------------------------------------------*/
+
+static int start_read (DWORD sector)  /* 1:OK, 0:Failed */                   //!< added:  see change 8
+{
+  if (ReadOpen && sector == ReadNext) return 1;
+
+  stop_read();
+  if (send_cmd(CMD18, (CardType & CT_BLOCK) ? sector : sector * 512) != 0) {  /* READ_MULTIPLE_BLOCK */
+    deselect();
+    return 0;
+  }
+  ReadOpen = 1;
+
+  return 1;
+}
+
+
+
 /*--------------------------------------------------------------------------
 
    Public Functions
@@ -390,6 +890,51 @@ DSTATUS disk_status (
 
 //! \cond CHANGED3
 
+/*-----------------------------------------------------------------------*/
+/* Get the highest SPI clock of the card from the CSD                    */
+/*-----------------------------------------------------------------------*/
+
+static DWORD card_clock (void)  /* Clock (Hz), at most SD_SPI_MAX */                //!< added:  see change 13
+{
+  static const BYTE tv[16] = { 0, 10, 12, 13, 15, 20, 25, 30, 35, 40, 45, 50, 55, 60, 70, 80 };  /* Time value x 10 */
+  BYTE n, csd[16];
+  DWORD f;
+
+
+  /* TRAN_SPEED: time value (1.0 .. 8.0) times rate unit (100 kbit/s .. 100 Mbit/s) */
+  if (send_cmd(CMD9, 0) != 0 || !rcvr_datablock(csd, 16)) return SD_SPI_INIT;  /* Keep the slow clock */
+  f = 10000;                    /* 100 kbit/s divided by 10 for the time value */
+  for (n = csd[3] & 7; n && f < 10000000; n--) f *= 10;
+  f *= tv[(csd[3] >> 3) & 15];
+
+  return f < SD_SPI_MAX ? f : SD_SPI_MAX;
+}
+
+/*-----------------------------------------------------------------------*/
+/* Steps of disk_read_async() and disk_write_async()                     */
+/*-----------------------------------------------------------------------*/
+
+#define AS_IDLE     0  /* No transfer */                                      //!< added:  see change 15
+#define AS_RD_TOKEN 1  /* Waiting for the data token of the next block */     //!< added:  see change 15
+#define AS_RD_DATA  2  /* Block received (or being received by DMA) */        //!< added:  see change 15
+#define AS_WR_READY 3  /* Waiting until the card is not busy */               //!< added:  see change 15
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Finish the running disk_*_async() and a disk_read_dma() transfer      */
+/*-----------------------------------------------------------------------*/
+
+static void async_idle (void)                                                 //!< added:  see change 15
+{
+  while (disk_async_poll()) {
+    if (Yield) Yield();
+  }
+  sdspi_dma_idle();
+}
+
+
+
 /*-----------------------------------------------------------------------*/
 /* Initialize Disk Drive                                                 */
 /*-----------------------------------------------------------------------*/
@@ -399,14 +944,19 @@ DSTATUS disk_initialize (
 )
 {
   BYTE n, ty, cmd, buf[4];
-  UINT tmr;
+  WORD end;
   DSTATUS s;
 
 
   if (drv) return RES_NOTRDY;
 
+  async_idle();       //! Changed: wait for disk_read_dma() and disk_*_async()
+  ReadOpen = 0;       //! Changed: the card is reset, an open read is gone
   dly_us(10000);      /* 10ms */
   sdspi_init();       //! Changed: this function uses now sdspi_init() for initialization  
+#if SD_TICK
+  sdtick_init();      //! Changed: 1 ms tick for the timeouts
+#endif
 
   for (n = 10; n; n--) rcvr_mmc(buf, 1);  /* Apply 80 dummy clocks and the card gets ready to receive command */
 
@@ -415,11 +965,9 @@ DSTATUS disk_initialize (
     if (send_cmd(CMD8, 0x1AA) == 1) {  /* SDv2? */
       rcvr_mmc(buf, 4);              /* Get trailing return value of R7 resp */
       if (buf[2] == 0x01 && buf[3] == 0xAA) {    /* The card can work at vdd range of 2.7-3.6V */
-        for (tmr = 1000; tmr; tmr--) {      /* Wait for leaving idle state (ACMD41 with HCS bit) */
-          if (send_cmd(ACMD41, 1UL << 30) == 0) break;
-          dly_us(1000);
-        }
-        if (tmr && send_cmd(CMD58, 0) == 0) {  /* Check CCS bit in the OCR */
+        end = sdtick_deadline(1000);  //! Changed: tick deadline
+        while ((n = send_cmd(ACMD41, 1UL << 30)) != 0 && sdtick_wait(end)) ;  /* Wait for leaving idle state (ACMD41 with HCS bit) */
+        if (n == 0 && send_cmd(CMD58, 0) == 0) {  /* Check CCS bit in the OCR */
           rcvr_mmc(buf, 4);
           ty = (buf[0] & 0x40) ? CT_SD2 | CT_BLOCK : CT_SD2;  /* SDv2 */
         }
@@ -430,17 +978,16 @@ DSTATUS disk_initialize (
       } else {
         ty = CT_MMC; cmd = CMD1;  /* MMCv3 */
       }
-      for (tmr = 1000; tmr; tmr--) {      /* Wait for leaving idle state */
-        if (send_cmd(cmd, 0) == 0) break;
-        dly_us(1000);
-      }
-      if (!tmr || send_cmd(CMD16, 512) != 0)  /* Set R/W block length to 512 */
+      end = sdtick_deadline(1000);    //! Changed: tick deadline
+      while ((n = send_cmd(cmd, 0)) != 0 && sdtick_wait(end)) ;  /* Wait for leaving idle state */
+      if (n != 0 || send_cmd(CMD16, 512) != 0)  /* Set R/W block length to 512 */
         ty = 0;
     }
   }
   CardType = ty;
   s = ty ? 0 : STA_NOINIT;
   Stat = s;
+  if (ty) SpiClock = sdspi_clock(card_clock());  //! Changed: the fastest clock the card allows
 
   deselect();
 
@@ -462,23 +1009,55 @@ DRESULT disk_read (
   UINT count      /* Sector count (1..128) */
 )
 {
-  BYTE cmd;
+  if (disk_status(drv) & STA_NOINIT) return RES_NOTRDY;
+  async_idle();      //! Changed: wait for disk_read_dma() and disk_*_async()
+
+  if (!start_read(sector)) return RES_ERROR;  //! Changed: continue the open read with the next sector
+  ReadNext = sector + count;
+  do {
+    if (!rcvr_datablock(buff, 512)) break;
+    buff += 512;
+  } while (--count);
+  if (count) stop_read();  /* Stop the read after an error */
 
+  return count ? RES_ERROR : RES_OK;
+}
 
+
+
+/*-----------------------------------------------------------------------*/
+/* Read a Sector with a completion callback                              */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_read_dma (                                                       //!< added:  see change 10
+  BYTE drv,      /* Physical drive nmuber (0) */
+  BYTE *buff,      /* Pointer to the data buffer to store read data (512 bytes) */
+  DWORD sector,    /* Sector number (LBA) */
+  void (*done)(DRESULT res)  /* Called at the end if RES_OK is returned, may be 0 */
+)
+{
+#if SD_DMA
   if (disk_status(drv) & STA_NOINIT) return RES_NOTRDY;
-  if (!(CardType & CT_BLOCK)) sector *= 512;  /* Convert LBA to byte address if needed */
+  async_idle();
 
-  cmd = count > 1 ? CMD18 : CMD17;      /*  READ_MULTIPLE_BLOCK : READ_SINGLE_BLOCK */
-  if (send_cmd(cmd, sector) == 0) {
-    do {
-      if (!rcvr_datablock(buff, 512)) break;
-      buff += 512;
-    } while (--count);
-    if (cmd == CMD18) send_cmd(CMD12, 0);  /* STOP_TRANSMISSION */
+  if (!start_read(sector)) return RES_ERROR;
+  if (!wait_token()) {
+    stop_read();
+    return RES_ERROR;
   }
-  deselect();
+  ReadNext = sector + 1;
+  SpiStat.data += 512;
+  DmaDone = done;
+  DmaBusy = 1;
+  sdspi_dma_start(buff, 0, 512, DMA_CH_TRNINTLVL_LO_gc);  /* CRC in the interrupt */
 
-  return count ? RES_ERROR : RES_OK;
+  return RES_OK;
+#else
+  DRESULT res = disk_read(drv, buff, sector, 1);
+
+  if (res == RES_OK && done) done(res);
+  return res;
+#endif
 }
 
 
@@ -495,6 +1074,8 @@ DRESULT disk_write (
 )
 {
   if (disk_status(drv) & STA_NOINIT) return RES_NOTRDY;
+  async_idle();      //! Changed: wait for disk_read_dma() and disk_*_async()
+  stop_read();       //! Changed: stop an open read first
   if (!(CardType & CT_BLOCK)) sector *= 512;  /* Convert LBA to byte address if needed */
 
   if (count == 1) {  /* Single block write */
@@ -532,10 +1113,31 @@ DRESULT disk_ioctl (
   DRESULT res;
   BYTE n, csd[16];
   DWORD cs;
+  BYTE sreg;
 
 
   if (disk_status(drv) & STA_NOINIT) return RES_NOTRDY;  /* Check if card is in the socket */
 
+  switch (ctrl) {    //! Changed: queries without the card keep an open read and a transfer running
+    case GET_BLOCK_SIZE :  /* Get erase block size in unit of sector (DWORD) */
+      *(DWORD*)buff = 128;
+      return RES_OK;
+
+    case MMC_GET_SPI_STAT :  /* Get the SPI counters (MMC_SPI_STAT) */
+      sreg = SREG;
+      cli();                 /* The DMA interrupt counts the CRC bytes */
+      *(MMC_SPI_STAT*)buff = SpiStat;
+      SREG = sreg;
+      return RES_OK;
+
+    case MMC_GET_SPI_CLOCK :  /* Get the SPI clock (DWORD, Hz) */
+      *(DWORD*)buff = SpiClock;
+      return RES_OK;
+  }
+
+  async_idle();      //! Changed: wait for disk_read_dma() and disk_*_async()
+  stop_read();       //! Changed: stop an open read first
+
   res = RES_ERROR;
   switch (ctrl) {
     case CTRL_SYNC :    /* Make sure that no pending write process */
@@ -556,8 +1158,17 @@ DRESULT disk_ioctl (
       }
       break;
 
-    case GET_BLOCK_SIZE :  /* Get erase block size in unit of sector (DWORD) */
-      *(DWORD*)buff = 128;
+    case MMC_STOP_READ :   /* Stop an open multiple block read (done above) */
+      res = RES_OK;
+      break;
+
+    case MMC_RCVR_LOOP :   /* Receive 512 bytes with rcvr_mmc(), card deselected (timing) */
+      rcvr_mmc(buff, 512);
+      res = RES_OK;
+      break;
+
+    case MMC_RCVR_FAST :   /* Receive 512 bytes with rcvr_mmc_fast(), card deselected (timing) */
+      rcvr_mmc_fast(buff, 512);
       res = RES_OK;
       break;
 
@@ -571,5 +1182,181 @@ DRESULT disk_ioctl (
 }
 //! \endcond
 
+//! \cond CHANGED4
+
+/*-----------------------------------------------------------------------*/
+/* Device Timer Interrupt Procedure                                      */
+/*-----------------------------------------------------------------------*/
+/* This function must be called in period of 1ms (TCE0 with SD_TICK 1)   */
+
+void disk_timerproc (void)                                                    //!< added:  see change 14
+{
+  Tick++;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Set the function that is called while the driver waits for the card  */
+/*-----------------------------------------------------------------------*/
+
+void disk_set_yield (                                                         //!< added:  see change 14
+  void (*func)(void)  /* Hook, 0: none. It must not use the card or SPIC */
+)
+{
+  Yield = func;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Start reading Sector(s), finished by disk_async_poll()                */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_read_async (                                                     //!< added:  see change 15
+  BYTE drv,      /* Physical drive nmuber (0) */
+  BYTE *buff,      /* Pointer to the data buffer to store read data */
+  DWORD sector,    /* Start sector number (LBA) */
+  UINT count,      /* Sector count (1..128) */
+  void (*done)(DRESULT res)  /* Called at the end if RES_OK is returned, may be 0 */
+)
+{
+  if (disk_status(drv) & STA_NOINIT) return RES_NOTRDY;
+  if (!count) return RES_PARERR;
+  async_idle();
+
+  if (!start_read(sector)) return RES_ERROR;
+  ReadNext = sector + count;
+  AsyncBuff = buff;
+  AsyncCount = count;
+  AsyncDone = done;
+  AsyncEnd = sdtick_deadline(100);  /* Wait for data packet in timeout of 100ms */
+  AsyncState = AS_RD_TOKEN;
+
+  return RES_OK;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Start writing Sector(s), finished by disk_async_poll()                */
+/*-----------------------------------------------------------------------*/
+
+DRESULT disk_write_async (                                                    //!< added:  see change 15
+  BYTE drv,      /* Physical drive nmuber (0) */
+  const BYTE *buff,  /* Pointer to the data to be written */
+  DWORD sector,    /* Start sector number (LBA) */
+  UINT count,      /* Sector count (1..128) */
+  void (*done)(DRESULT res)  /* Called at the end if RES_OK is returned, may be 0 */
+)
+{
+  if (disk_status(drv) & STA_NOINIT) return RES_NOTRDY;
+  if (!count) return RES_PARERR;
+  async_idle();
+  stop_read();
+  if (!(CardType & CT_BLOCK)) sector *= 512;  /* Convert LBA to byte address if needed */
+
+  if (count == 1) {  /* Single block write */
+    AsyncToken = 0xFE;
+    if (send_cmd(CMD24, sector) != 0) {  /* WRITE_BLOCK */
+      deselect();
+      return RES_ERROR;
+    }
+  }
+  else {        /* Multiple block write */
+    AsyncToken = 0xFC;
+    if (CardType & CT_SDC) send_cmd(ACMD23, count);
+    if (send_cmd(CMD25, sector) != 0) {  /* WRITE_MULTIPLE_BLOCK */
+      deselect();
+      return RES_ERROR;
+    }
+  }
+  AsyncBuff = (BYTE*)buff;
+  AsyncCount = count;
+  AsyncDone = done;
+  AsyncEnd = sdtick_deadline(500);  /* Wait for ready in timeout of 500ms */
+  AsyncState = AS_WR_READY;
+
+  return RES_OK;
+}
+
+
+
+/*-----------------------------------------------------------------------*/
+/* Advance disk_read_async() or disk_write_async()                       */
+/*-----------------------------------------------------------------------*/
+/* Each call polls the card once and moves at most one block. The        */
+/* callback is called from here, so it may start the next transfer.      */
+
+int disk_async_poll (void)  /* 1:Busy, 0:Idle */                               //!< added:  see change 15
+{
+  BYTE d[2];
+  DRESULT res = RES_OK;
+
+
+  switch (AsyncState) {
+    case AS_IDLE :
+      return 0;
+
+    case AS_RD_TOKEN :    /* Wait for the data token, then receive the block */
+      rcvr_mmc(d, 1);
+      if (d[0] == 0xFF && sdtick_before(AsyncEnd)) return 1;
+      if (d[0] != 0xFE) {  /* Timeout or error token */
+        stop_read();
+        res = RES_ERROR;
+        break;
+      }
+      SpiStat.data += 512;
+#if SD_DMA
+      DmaDone = 0;
+      DmaBusy = 1;
+      sdspi_dma_start(AsyncBuff, 0, 512, DMA_CH_TRNINTLVL_LO_gc);  /* CRC in the interrupt */
+#else
+      rcvr_mmc_block(AsyncBuff, 512);
+      rcvr_mmc(d, 2);      /* Discard CRC */
+#endif
+      AsyncState = AS_RD_DATA;
+      return 1;
+
+    case AS_RD_DATA :     /* Next block after the DMA transfer */
+#if SD_DMA
+      if (DmaBusy) return 1;
+#endif
+      AsyncBuff += 512;
+      if (--AsyncCount == 0) break;
+      AsyncEnd = sdtick_deadline(100);
+      AsyncState = AS_RD_TOKEN;
+      return 1;
+
+    case AS_WR_READY :    /* Wait for the card, then send a block or the stop token */
+      rcvr_mmc(d, 1);
+      if (d[0] != 0xFF && sdtick_before(AsyncEnd)) return 1;
+      if (d[0] != 0xFF) {  /* Timeout */
+        res = RES_ERROR;
+      } else if (AsyncCount) {
+        if (xmit_datablock(AsyncBuff, AsyncToken)) {
+          AsyncBuff += 512;
+          AsyncCount--;
+          AsyncEnd = sdtick_deadline(500);
+          return 1;
+        }
+        res = RES_ERROR;
+      } else if (AsyncToken == 0xFC) {
+        xmit_datablock(0, 0xFD);  /* STOP_TRAN token, then wait for the end of the busy time */
+        AsyncToken = 0xFE;
+        AsyncEnd = sdtick_deadline(500);
+        return 1;
+      }
+      if (res != RES_OK && AsyncToken == 0xFC) xmit_datablock(0, 0xFD);
+      deselect();
+      break;
+  }
+  AsyncState = AS_IDLE;
+  if (AsyncDone) AsyncDone(res);
+
+  return 0;
+}
+//! \endcond
+
 
 
@@ -24,6 +24,42 @@
  *               <tr><td>ff/ sdmm.c             </td><td>Customized version Chan's Sample \e generic release 11a</td></tr>
  *               <tr><td>sdcard_test_sdmm.c     </td><td>This example</td></tr>
  *               <tr><td>demo_ff.c              </td><td>function with demo SD-card</td></tr>
+ *               <tr><td>audio/player.c         </td><td>Buffered WAV playback engine</td></tr>
+ *               <tr><td>audio/player.h         </td><td>Buffered WAV playback engine</td></tr>
+ *               <tr><td>audio/ring.c           </td><td>Lock-free sample ring buffer</td></tr>
+ *               <tr><td>audio/ring.h           </td><td>Lock-free sample ring buffer</td></tr>
+ *               <tr><td>audio/sampleclock.c    </td><td>Sample clock with exact average rate</td></tr>
+ *               <tr><td>audio/sampleclock.h    </td><td>Sample clock with exact average rate</td></tr>
+ *               <tr><td>audio/resample.c       </td><td>Polyphase sample-rate converter</td></tr>
+ *               <tr><td>audio/resample.h       </td><td>Polyphase sample-rate converter</td></tr>
+ *               <tr><td>audio/resample_coef.h  </td><td>Filter tables (tools/gen_resample_coef.c)</td></tr>
+ *               <tr><td>audio/pcm.c            </td><td>PCM decode kernels</td></tr>
+ *               <tr><td>audio/pcm.h            </td><td>PCM decode kernels</td></tr>
+ *               <tr><td>audio/adpcm.c          </td><td>IMA ADPCM decoder</td></tr>
+ *               <tr><td>audio/adpcm.h          </td><td>IMA ADPCM decoder</td></tr>
+ *               <tr><td>audio/mixer.c          </td><td>Software mixer for overlapping sounds</td></tr>
+ *               <tr><td>audio/mixer.h          </td><td>Software mixer for overlapping sounds</td></tr>
+ *               <tr><td>audio/gain.c           </td><td>Fixed-point gain with ramps</td></tr>
+ *               <tr><td>audio/gain.h           </td><td>Fixed-point gain with ramps</td></tr>
+ *               <tr><td>audio/synth.c          </td><td>Wavetable tone synthesizer</td></tr>
+ *               <tr><td>audio/synth.h          </td><td>Wavetable tone synthesizer</td></tr>
+ *               <tr><td>audio/flashbank.c      </td><td>Sound bank in program flash</td></tr>
+ *               <tr><td>audio/flashbank.h      </td><td>Sound bank in program flash</td></tr>
+ *               <tr><td>audio/flashbank_data.h </td><td>Clips of the sound bank (tools/mkflashbank.c)</td></tr>
+ *               <tr><td>audio/soundbank.c      </td><td>Sound bank container on the SD-card</td></tr>
+ *               <tr><td>audio/soundbank.h      </td><td>Sound bank container on the SD-card</td></tr>
+ *               <tr><td>audio/clipindex.c      </td><td>RAM index of the WAV files</td></tr>
+ *               <tr><td>audio/clipindex.h      </td><td>RAM index of the WAV files</td></tr>
+ *               <tr><td>audio/headcache.c      </td><td>RAM cache with the start of hot clips</td></tr>
+ *               <tr><td>audio/headcache.h      </td><td>RAM cache with the start of hot clips</td></tr>
+ *               <tr><td>audio/wav.c            </td><td>WAV file header</td></tr>
+ *               <tr><td>audio/wav.h            </td><td>WAV file header</td></tr>
+ *               <tr><td>audio/dac.c            </td><td>Audio output (interrupt or DMA)</td></tr>
+ *               <tr><td>audio/dac.h            </td><td>Audio output (interrupt or DMA)</td></tr>
+ *               <tr><td>audio/latency.c        </td><td>Start latency measurement</td></tr>
+ *               <tr><td>audio/latency.h        </td><td>Start latency measurement</td></tr>
+ *               <tr><td>audio/cycles.c         </td><td>Cycle measurements</td></tr>
+ *               <tr><td>audio/cycles.h         </td><td>Cycle measurements</td></tr>
  *               </table>
  *           </li><li> Add all c-files to the project
  *           </li><li> Change the four defines in ffconf.h
@@ -56,88 +92,214 @@
 #include "clock/clock.h"
 #include "serialF0/serialF0.h"
 #include <util/delay.h>
+#include "audio/player.h"
+#include "audio/dac.h"
+#include "audio/sampleclock.h"
+#include "audio/pcm.h"
+#include "audio/adpcm.h"
+#include "audio/headcache.h"
+#include "audio/latency.h"
+#include "audio/mixer.h"
+#include "audio/soundbank.h"
+#include "audio/clipindex.h"
+#include "diskio.h"
 
-FATFS FatFs;                        // Bestandssysteem object
-FIL file;                  // Bestand object
-UINT br;                   // Bytes gelezen
-volatile uint8_t sampleBuffer[256];  // 16-bit buffer
-volatile uint16_t bufferIndex = 0;
-volatile uint16_t bufferSize = 0;
-
+#define AUDIO_OUT  DAC_OUT_DMA      // DAC_OUT_ISR: interrupt per sample, DAC_OUT_DMA: DMA
 
+#ifndef BENCH_RCVR
+#define BENCH_RCVR   0              // 1: meet de ontvangstlussen van sdmm.c bij het starten
+#endif
+#ifndef BENCH_ASYNC
+#define BENCH_ASYNC  0              // 1: meet disk_read_async() bij het starten (leest sector 0..15)
+#endif
 
+FATFS FatFs;                        // Bestandssysteem object
 
-void init_dac(void)
-{
-  DACB.CTRLC = DAC_REFSEL_AVCC_gc;
-  DACB.CTRLB = DAC_CHSEL_SINGLE_gc;
-  DACB.CTRLA = DAC_CH0EN_bm | DAC_ENABLE_bm;
-}
 
 int demo_ff(void);
 void play_wav();
+void play_sound();
 int read_wav_header(const char *filename);
 
-void sd_init()
+FRESULT sd_init()
 {
-  if (f_mount(&FatFs, "", 1) != FR_OK)
+  FRESULT res = f_mount(&FatFs, "", 1);
+
+  if (res != FR_OK)
   {
     printf("SD-kaart mounten mislukt!\n");
-    while (1)
-      ;
+    return res;
   }
-  printf("SD-kaart gemount!\n");
+  DWORD klok;
+  disk_ioctl(0, MMC_GET_SPI_CLOCK, &klok);      // gekozen uit TRAN_SPEED van de CSD
+  printf("SD-kaart gemount! SPI-klok %lu kHz\n", klok / 1000);
+  return FR_OK;
 }
 
-void timer_init()
+void play_flash(const char *name)      // speelt een clip uit flash, zonder SD-kaart
 {
-  TCC0.CTRLA = TC_CLKSEL_DIV1_gc;     // Start timer met
-  TCC0.PER = 1999;                    // Stel periode in voor 16 kHz
-  TCC0.CTRLB = TC_WGMODE_NORMAL_gc;   // Normale mode
-  TCC0.INTCTRLA = TC_OVFINTLVL_LO_gc; // Interrupt bij overflow
-  PMIC.CTRL |= PMIC_LOLVLEN_bm;       // Zet Low Level Interrupts aan
+  if (player_flash(name, MIXER_UNITY) == MIXER_NONE)
+  {
+    printf("Clip %s staat niet in flash!\n", name);
+    return;
+  }
+  sampleclock_set(player_rate());
+  sei();
+  dac_start();
+  while (player_service())
+    ;
+  dac_stop();
 }
 
+#if BENCH_RCVR
+void bench_rcvr(void)                  // cycles per sector van de ontvangstlussen in sdmm.c
+{
+  BYTE sector[512];
+  uint32_t t0, t1, t2;
+
+  t0 = latency_now();                  // 32 bits: bij een trage klok > 65535 cycles
+  disk_ioctl(0, MMC_RCVR_LOOP, sector);   // byte voor byte, kaart niet geselecteerd
+  t1 = latency_now();
+  disk_ioctl(0, MMC_RCVR_FAST, sector);   // overlappend en uitgerold
+  t2 = latency_now();
+  printf("Sector ontvangen: %lu cycles (%lu kB/s), snel %lu cycles (%lu kB/s)\n",
+         t1 - t0, 512UL * (F_CPU / 1000) / (t1 - t0),
+         t2 - t1, 512UL * (F_CPU / 1000) / (t2 - t1));
+}
+#endif
+
+#if BENCH_ASYNC
+void bench_async(void)                 // leest sectoren zonder op de kaart te wachten
+{
+  BYTE sector[512];
+  uint32_t vrij = 0;
+
+  for (DWORD s = 0; s < 16; s++)
+  {
+    if (disk_read_async(0, sector, s, 1, 0) != RES_OK)
+    {
+      return;
+    }
+    while (disk_async_poll())          // hier kan ander werk, de kaart is nog bezig
+    {
+      vrij++;
+    }
+  }
+  disk_ioctl(0, CTRL_SYNC, 0);         // stopt de open CMD18
+  printf("Async: 16 sectoren, %lu keer vrij tijdens de kaartlatentie\n", vrij);
+}
+#endif
+
 int main(void)
 {
 
   init_clock();
-  timer_init();
-  init_dac();
+  cycles_init();
+  latency_init();
+  timer_init(AUDIO_OUT);
+  init_dac(AUDIO_OUT);
   init_stream(F_CPU);
   _delay_ms(10);
-  sd_init();
+  if (sd_init() != FR_OK)              // geen kaart: deurbel uit flash
+  {
+    play_flash("chime");
+    while (1)
+      ;
+  }
+#if BENCH_RCVR
+  bench_rcvr();                        // vergelijk SPIC met SD_USART 1 (USARTC1 in MSPI)
+#endif
+#if BENCH_ASYNC
+  bench_async();
+#endif
+  uint8_t geladen;
+  if (clipindex_mount("clips.idx", &geladen) == FR_OK)  // openen zonder directory te lezen
+  {
+    printf("Index: %u bestanden (%s)\n", clipindex_count(), geladen ? "geladen" : "nieuw");
+  }
+  if (soundbank_mount("sounds.bnk") != FR_OK)   // tools/sbpack.c
+  {
+    printf("Geen geldige sounds.bnk, bel.wav wordt gebruikt\n");
+  }
+  MMC_SPI_STAT sd_start, sd_eind;
+  disk_ioctl(0, MMC_GET_SPI_STAT, &sd_start);   // SPI-tellers van sdmm.c
+  player_cache("audio.wav");           // begin van de deurbel in RAM
 
-  if (f_open(&file, "audio.wav", FA_READ) != FR_OK)
+  if (player_open("audio.wav") != FR_OK)   // opent bestand en vult de buffers
   {
     printf("Kan bestand niet openen!\n");
+    play_flash("chime");
     while (1)
       ;
   }
-_delay_ms(10);
-  f_lseek(&file, 44); // Header overslaan
+  player_queue("audio2.wav");          // speelt zonder pauze verder na audio.wav
+  sampleclock_set(player_rate());      // vaste DAC-rate, andere rates worden omgezet
   sei();
+  dac_start();
+
+  uint8_t bel = MIXER_NONE;
+  if (player_clip(1, gain_db(-6), &bel) != FR_OK)     // bel over de melodie, 6 dB zachter
+  {
+    player_overlay("bel.wav", gain_db(-6), &bel);    // zonder sound bank: als los bestand
+  }
+
+  while (player_service())             // vul vrije buffers bij, eindigt op mid-scale
+    ;
+
+  dac_stop();                          // Stop als we klaar zijn, zonder klik
+
+  player_stats_t st;
+  cycles_t load;
+  uint32_t outputs;
+  player_get_stats(&st);
+  dac_get_load(&load);
+  printf("Samples: %lu, underruns: %u\n", st.samples, st.underruns);
+  printf("Ring vulling: min %u, max %u samples\n", st.ring_low, st.ring_high);
+  disk_ioctl(0, MMC_GET_SPI_STAT, &sd_eind);
+  sd_eind.data -= sd_start.data;
+  sd_eind.bytes -= sd_start.bytes + sd_eind.data;      // bytes naast de datablokken
+  if (sd_eind.data) {
+    printf("SD: %lu commando's, overhead %lu bytes per MB\n", sd_eind.cmds - sd_start.cmds,
+           (uint32_t) ((uint64_t) sd_eind.bytes * 1048576 / sd_eind.data));
+  }
+  headcache_stats_t hs;
+  headcache_get_stats(&hs);
+  printf("Cache: hits %u, missers %u, overnames %u (te laat %u, mislukt %u), %u bytes\n",
+         hs.hits, hs.misses, hs.handovers, hs.late, hs.failed, hs.used);
+  printf("Tracks: %u, overgeslagen: %u, gat: %u (max %u) samples\n",
+         st.tracks, st.skipped, st.gap, st.gap_max);
+  if (st.samples) {                    // alleen gemeten met AUDIO_PROFILE 1
+    printf("DAC-interrupts: %u, cycles/sample: %lu, max: %u\n",
+           load.count, load.total / st.samples, load.max);
+  }
+  resample_get_load(&load, &outputs);
+  if (outputs) {
+    printf("Resampler cycles/sample: %lu\n", load.total / outputs);
+  }
+  pcm_get_load(&load, &outputs);
+  if (load.total) {                    // bytes per cycle = bytes / cycles
+    printf("Decoder: %lu bytes in %lu cycles\n", outputs, load.total);
+  }
+  player_get_read_load(&load, &outputs);
+  printf("Blokken: %u, waarvan %u direct via extents\n", st.blocks, st.direct);
+  if (load.total) {                    // vergelijk met PLAYER_EXTENTS 0 (alleen f_read)
+    printf("Lezen: %lu bytes in %lu cycles, %lu kB/s, max %u cycles\n", outputs, load.total,
+           (uint32_t) ((uint64_t) outputs * (F_CPU / 1000) / load.total), load.max);
+  }
+  adpcm_get_load(&load, &outputs);
+  if (outputs) {
+    printf("ADPCM cycles/sample: %lu\n", load.total / outputs);
+  }
+  for (uint8_t v = 1; v <= MIXER_VOICES; v++) {   // alleen gemeten met AUDIO_PROFILE 1
+    mixer_get_load(v, &load, &outputs);
+    if (outputs) {
+      printf("Mixer %u stemmen: %lu cycles/sample\n", v, load.total / outputs);
+    }
+  }
+  latency_print();                     // tijd van aanvraag tot eerste sample
 
   while (1)
   {
 
   } // do nothing
 }
-
-ISR(TCC0_OVF_vect) {
-    if (bufferIndex < bufferSize) {
-        // Zet sample om naar DAC (8-bit unsigned naar 12-bit DAC)
-        DACB.CH0DATA = sampleBuffer[bufferIndex] << 4;
-        bufferIndex++;
-    } else {
-        // Lees nieuw audioblok in
-        f_read(&file, (void *)sampleBuffer, sizeof(sampleBuffer), &br);
-        bufferSize = br;
-        bufferIndex = 0;
-
-        if (br == 0) { 
-            TCC0.CTRLA = 0;  // Stop als we klaar zijn
-            f_close(&file);
-        }
-    }
-}
\ No newline at end of file
@@ -0,0 +1,217 @@
+/*!
+ *  \file    adpcmcheck.c
+ *  \brief   Checks audio/adpcm.c against stored reference output
+ *
+ *  \details Host program (Linux). Build and run it from the project folder:
+ *           \verbatim
+               gcc -O2 -no-pie -Itools/host -I. -Iff -o adpcmcheck \
+                   tools/adpcmcheck.c audio/adpcm.c audio/cycles.c tools/host/host.c
+               ./adpcmcheck \endverbatim
+ *
+ *           The fixtures are IMA ADPCM blocks of a mono and a stereo file.
+ *           They start at silence, at full scale and with a step index
+ *           above 88, saturate with runs of 0x7 and 0xF codes, and end with
+ *           a short last block: 13 data bytes (mono), two groups and an
+ *           incomplete one (stereo), and 3 bytes without room for the
+ *           header (mono). Every fixture is decoded with adpcm_decode()
+ *           calls of 1, 2, 3, 7, 8, 9 and 64 frames, so the groups are split
+ *           over the calls in all ways, and the 12-bit DAC codes must match
+ *           the reference bit-exact.
+ *
+ *           The reference output was made with a separate implementation of
+ *           the IMA ADPCM algorithm (IMA Digital Audio Recommended
+ *           Practices) with the same conversion to DAC codes: offset binary
+ *           >> 4, and for stereo (left >> 1) + (right >> 1), >> 4. The exit
+ *           code is 0 if all fixtures match.
+ */
+#include <stdio.h>
+#include <stdint.h>
+
+#include "audio/adpcm.h"
+
+#define ELEMENTS(a)  (sizeof(a) / sizeof((a)[0]))
+
+// mono, block_align 36 (65 frames): blocks of 36, 36, 36, 17 and 3 bytes
+static const uint8_t mono_blk0[36] = {
+  0x00, 0x00, 0x00, 0x00, 0xDC, 0x04, 0x65, 0xAA, 0x1F, 0xAD, 0x1D, 0x5A,
+  0xDA, 0xE5, 0xAC, 0x1B, 0x1E, 0x5F, 0x13, 0x70, 0x79, 0x6C, 0xFD, 0x10,
+  0xFF, 0x19, 0xAF, 0x60, 0x1D, 0x04, 0xAC, 0xB4, 0x1D, 0x02, 0x2B, 0x46,
+};
+static const uint8_t mono_blk1[36] = {
+  0xD0, 0x8A, 0x3C, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0x78, 0x73, 0x3A, 0xF2, 0xDF, 0x5F, 0xAE, 0xB7,
+  0x08, 0x59, 0xD1, 0xEE, 0x39, 0x10, 0xCB, 0x48, 0x95, 0xB5, 0xCC, 0x89,
+};
+static const uint8_t mono_blk2[36] = {
+  0x00, 0x7D, 0x46, 0x00, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77,
+  0x77, 0x77, 0x77, 0x77, 0x29, 0x11, 0xFF, 0x06, 0xB6, 0x62, 0x2E, 0xDF,
+  0x3C, 0xF9, 0x35, 0xFD, 0x4B, 0x94, 0x28, 0xCA, 0x09, 0x7C, 0x44, 0xB3,
+};
+static const uint8_t mono_blk3[17] = {
+  0xD2, 0x04, 0x64, 0x00, 0x02, 0x5E, 0x96, 0x5F, 0xB3, 0xEA, 0x6D, 0xAC,
+  0xD4, 0x2D, 0x81, 0x6E, 0x69,
+};
+static const uint8_t mono_blk4[3] = {
+  0x01, 0x02, 0x03,
+};
+static const uint16_t mono_ref[222] = {
+  2048, 2047, 2046, 2047, 2047, 2048, 2051, 2049, 2048, 2044,
+  2046, 2041, 2037, 2030, 2033, 2029, 2037, 2032, 2021, 2037,
+  2009, 1974, 1951, 1921, 1932, 1887, 1905, 1821, 1954, 2078,
+  2127, 2141, 2341, 2255, 2645, 2144, 3020, 1706,    0,  255,
+   954,    0,    0,    0,  698,    0,    0,  232, 2983,  167,
+   935, 3030, 3286, 1191,    0, 2094,  303,    0,  767, 1931,
+  2143,  796, 1671, 3737, 4095,  173,    0,    0,    0,    0,
+     0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+     0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+     0, 3491, 4095, 4095, 2816, 4095, 4095, 1210,    0,    0,
+     0, 2815,    0,    0, 3491, 1699, 1466, 1678, 1101, 3025,
+  3793, 1232,    0,    0,    0, 1629, 1840, 2417, 1193,    0,
+     0, 1573, 3901, 3133, 4095, 2304,  209,    0,    0,    0,
+  4048, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+  4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095, 4095,
+  4095, 4095, 4095, 4095, 4095, 3328, 4095, 4095, 4095, 1472,
+     0, 3327, 3583, 4095, 2304, 3467, 4095,  768, 2048,    0,
+     0,    0, 1791, 1093,    0, 2815, 4095, 1535,    0,    0,
+  2094, 4095, 3328, 3095, 4095, 3134, 1560,  925, 1117,    0,
+  3174, 4095, 4095, 4095, 2466, 2125, 3405, 3637,  886, 3702,
+  4095, 3328,    0, 2815, 4095, 2466, 1408,    0,    0, 3327,
+  1023,    0, 2094,    0,    0, 1279, 1978, 1766,    0, 3327,
+  2559, 4095,
+};
+
+// stereo, block_align 40 (33 frames): blocks of 40, 40, 40 and 29 bytes
+static const uint8_t stereo_blk0[40] = {
+  0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x03, 0x00, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xAF, 0xE0, 0xE6, 0x87,
+  0x4C, 0x9C, 0x04, 0xE7, 0xD2, 0x36, 0x5D, 0x2C, 0x60, 0xC9, 0xEA, 0xF4,
+  0x79, 0xF6, 0x86, 0xA0,
+};
+static const uint8_t stereo_blk1[40] = {
+  0xFF, 0x7F, 0x58, 0x00, 0x00, 0x80, 0x58, 0x00, 0x77, 0x77, 0x77, 0x77,
+  0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0x77, 0xEB, 0x93, 0x26, 0xE4,
+  0x62, 0x12, 0xD5, 0x0D, 0xCB, 0xB3, 0x77, 0x15, 0x6A, 0x6A, 0x3A, 0x68,
+  0xBA, 0x8E, 0xDB, 0x74,
+};
+static const uint8_t stereo_blk2[40] = {
+  0xE0, 0xB1, 0x14, 0x00, 0x00, 0x00, 0x5F, 0x00, 0x08, 0x46, 0x9E, 0xF3,
+  0xCE, 0xB3, 0x0A, 0xF8, 0xD0, 0xDD, 0x68, 0xBB, 0xF8, 0x5F, 0xFA, 0x24,
+  0xF2, 0xD2, 0xFC, 0x18, 0x87, 0xFB, 0x5C, 0x87, 0xBA, 0xB4, 0x38, 0x32,
+  0xA5, 0x9B, 0x1B, 0x3D,
+};
+static const uint8_t stereo_blk3[29] = {
+  0x64, 0x00, 0x0A, 0x00, 0x9C, 0xFF, 0x0A, 0x00, 0x10, 0x7C, 0xF7, 0x78,
+  0xD6, 0x7F, 0xE2, 0x6D, 0xF8, 0x11, 0x91, 0x29, 0x7E, 0x93, 0x95, 0xCB,
+  0x12, 0xC5, 0x57, 0xCE, 0x5A,
+};
+static const uint16_t stereo_ref[116] = {
+  2047, 2047, 2044, 2040, 2030, 2009, 1963, 1864, 1652, 1198,
+   594,  386,    0,  705,    0, 1919, 1791, 2047, 2036, 2047,
+  2047, 1815, 3223, 2943, 1920, 1698, 4072, 3689,  721, 1792,
+  1664, 2932, 1251, 2047, 3967, 4095, 4095, 4095, 4095, 4095,
+  4095, 4095, 3200, 2047, 2943, 2594, 3970, 4095, 4095, 2432,
+  2047, 2047, 2943, 2129, 3716, 2688, 2047, 2175, 1466, 2100,
+   735, 2047, 1408, 2047, 3094, 4095, 1423,  398,  398, 1296,
+   484,  399,  493,  409,  393,  394,  383,  367, 1752, 1109,
+   378, 1495, 2103, 2379, 2195, 1421,  235,  138, 1407, 2047,
+  1995, 2047, 1408,  764,  286,    0,  395,  219, 1144, 2048,
+  2049, 2047, 2044, 2051, 2058, 2042, 2026, 2063, 2013, 2093,
+  2202, 2170, 2307, 2249, 2133, 2013,
+};
+
+/*! \brief  A file of fixture blocks with its reference output */
+typedef struct {
+  const char     *name;
+  uint16_t        channels;
+  uint16_t        block_align;
+  const uint8_t  *blk[5];
+  uint16_t        len[5];
+  uint8_t         blocks;
+  const uint16_t *ref;
+  uint16_t        frames;
+} fixture_t;
+
+static const fixture_t fixtures[] = {
+  { "mono", 1, 36,
+    { mono_blk0, mono_blk1, mono_blk2, mono_blk3, mono_blk4 },
+    { sizeof(mono_blk0), sizeof(mono_blk1), sizeof(mono_blk2), sizeof(mono_blk3), sizeof(mono_blk4) },
+    5, mono_ref, ELEMENTS(mono_ref) },
+  { "stereo", 2, 40,
+    { stereo_blk0, stereo_blk1, stereo_blk2, stereo_blk3 },
+    { sizeof(stereo_blk0), sizeof(stereo_blk1), sizeof(stereo_blk2), sizeof(stereo_blk3) },
+    4, stereo_ref, ELEMENTS(stereo_ref) },
+};
+
+static const uint16_t chunks[] = { 1, 2, 3, 7, 8, 9, 64 };
+
+/*! \brief  Decode a fixture in calls of at most n frames and compare
+ *
+ *  \param  f        fixture
+ *  \param  n        frames per adpcm_decode() call
+ *
+ *  \return number of errors
+ */
+static int check(const fixture_t *f, uint16_t n)
+{
+  wav_info_t info = { 0 };
+  adpcm_t    ad;
+  uint16_t   out[64];
+  uint16_t   got = 0, k, i;
+  uint8_t    b;
+
+  info.format      = WAV_FORMAT_IMA_ADPCM;
+  info.channels    = f->channels;
+  info.bits        = 4;
+  info.block_align = f->block_align;
+  if ( !adpcm_init(&ad, &info) ) {
+    printf("%s: adpcm_init() failed\n", f->name);
+    return 1;
+  }
+
+  for (b = 0; b < f->blocks; b++) {
+    adpcm_begin(&ad, f->blk[b], f->len[b]);
+    while ( !adpcm_done(&ad) ) {
+      k = adpcm_decode(&ad, out, n);
+      for (i = 0; i < k; i++, got++) {
+        if (got >= f->frames) {
+          printf("%s, n=%u: more than %u frames\n", f->name, n, f->frames);
+          return 1;
+        }
+        if (out[i] != f->ref[got]) {
+          printf("%s, n=%u: frame %u (block %u) is %u, expected %u\n",
+                 f->name, n, got, b, out[i], f->ref[got]);
+          return 1;
+        }
+      }
+    }
+  }
+  if (got != f->frames) {
+    printf("%s, n=%u: %u frames, expected %u\n", f->name, n, got, f->frames);
+    return 1;
+  }
+
+  return 0;
+}
+
+int main(void)
+{
+  wav_info_t info = { 0 };
+  int        errors = 0;
+  unsigned   f, c;
+
+  for (f = 0; f < ELEMENTS(fixtures); f++) {
+    info.channels    = fixtures[f].channels;
+    info.block_align = fixtures[f].block_align;
+    if (adpcm_block_frames(&info) != (fixtures[f].channels == 1 ? 65 : 33)) {
+      printf("%s: adpcm_block_frames() is %u\n", fixtures[f].name, adpcm_block_frames(&info));
+      errors++;
+    }
+    for (c = 0; c < ELEMENTS(chunks); c++) {
+      errors += check(&fixtures[f], chunks[c]);
+    }
+    printf("%s: %u frames checked\n", fixtures[f].name, fixtures[f].frames);
+  }
+  printf(errors ? "FAILED\n" : "OK\n");
+
+  return errors != 0;
+}
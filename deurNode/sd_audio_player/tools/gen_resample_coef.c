@@ -0,0 +1,116 @@
+/*!
+ *  \file    gen_resample_coef.c
+ *  \brief   Generates audio/resample_coef.h with the polyphase filter tables
+ *
+ *  \details Host program (Linux). Build and run it from the project folder:
+ *           \verbatim
+               gcc -O2 -o gen_resample_coef tools/gen_resample_coef.c -lm
+               ./gen_resample_coef 16000 > audio/resample_coef.h \endverbatim
+ *
+ *           The argument is the output rate of the resampler. For every
+ *           supported input rate a table of RESAMPLE_PHASES phases is made.
+ *           Each phase is a windowed sinc (Blackman window) for a fractional
+ *           delay of phase/RESAMPLE_PHASES input samples, with the cut-off at
+ *           45% of the lowest of the two rates. The taps of a phase are
+ *           rounded to Q15 and sum exactly to 32768, so mid-scale (silence)
+ *           passes the filter unchanged.
+ *
+ *           When the input rate is higher than the output rate the filter is
+ *           made longer in proportion, to keep the transition band.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#define PHASES     32                   // must match RESAMPLE_PHASES in resample.h
+#define TAPS_UP    8                    // taps when upsampling
+
+static const long rates[] = { 8000, 11025, 22050, 44100 };
+
+static double sinc(double x)
+{
+  return x == 0.0 ? 1.0 : sin(M_PI * x) / (M_PI * x);
+}
+
+static int taps_for(long fin, long fout)
+{
+  int t;
+
+  if (fin <= fout) return TAPS_UP;
+  t = (int) ceil((double) TAPS_UP * fin / fout);
+
+  return (t + 1) & ~1;
+}
+
+static void make_phase(int16_t *c, int taps, int p, double fc)
+{
+  double h[64], sum = 0.0, d, w;
+  long   q, total = 0;
+  int    t, big = 0;
+
+  for (t = 0; t < taps; t++) {
+    d    = t - (taps / 2 - 1) - (double) p / PHASES;   // distance in input samples
+    w    = 0.42 + 0.5 * cos(2 * M_PI * d / taps) + 0.08 * cos(4 * M_PI * d / taps);
+    h[t] = 2 * fc * sinc(2 * fc * d) * w;
+    sum += h[t];
+  }
+  for (t = 0; t < taps; t++) {
+    q = lround(h[t] / sum * 32768.0);
+    c[t] = (int16_t) q;
+    total += q;
+    if (abs(c[t]) > abs(c[big])) big = t;
+  }
+  c[big] += (int16_t) (32768 - total);                // exact unity gain
+}
+
+int main(int argc, char *argv[])
+{
+  long    fout, fin;
+  double  fc;
+  int16_t c[64];
+  int     r, p, t, taps;
+  size_t  n = sizeof(rates) / sizeof(rates[0]);
+
+  if (argc != 2 || (fout = atol(argv[1])) <= 0) {
+    fprintf(stderr, "usage: %s output_rate\n", argv[0]);
+    return 1;
+  }
+
+  printf("/*!\n");
+  printf(" *  \\file    resample_coef.h\n");
+  printf(" *  \\brief   Polyphase filter tables for an output rate of %ld Hz\n", fout);
+  printf(" *\n");
+  printf(" *  \\details Generated by tools/gen_resample_coef.c, do not edit.\n");
+  printf(" */\n");
+  printf("#ifndef RESAMPLE_COEF_H_\n#define RESAMPLE_COEF_H_\n\n");
+  printf("#include <avr/pgmspace.h>\n\n");
+  printf("#define RESAMPLE_COEF_RATE  %ld     //!< output rate of these tables\n\n", fout);
+
+  for (r = 0; r < (int) n; r++) {
+    fin  = rates[r];
+    if (fin == fout) continue;
+    taps = taps_for(fin, fout);
+    fc   = 0.45 * (fin < fout ? fin : fout) / fin;    // relative to the input rate
+    printf("static const int16_t resample_coef_%ld[%d][%d] PROGMEM = {\n", fin, PHASES, taps);
+    for (p = 0; p < PHASES; p++) {
+      make_phase(c, taps, p, fc);
+      printf("  {");
+      for (t = 0; t < taps; t++) {
+        printf("%6d%s", c[t], t < taps - 1 ? "," : "");
+      }
+      printf(" }%s\n", p < PHASES - 1 ? "," : "");
+    }
+    printf("};\n\n");
+  }
+
+  printf("static const resample_table_t resample_tables[] = {\n");
+  for (r = 0; r < (int) n; r++) {
+    fin = rates[r];
+    if (fin == fout) continue;
+    printf("  { %5ld, %2d, &resample_coef_%ld[0][0] },\n", fin, taps_for(fin, fout), fin);
+  }
+  printf("};\n\n#endif // RESAMPLE_COEF_H_\n");
+
+  return 0;
+}
@@ -0,0 +1,26 @@
+/*!
+ *  \file    io.h
+ *  \brief   Host shim of <avr/io.h> for the audio engine
+ *
+ *  \details Only the registers of the files in the host build are here:
+ *           TCD0 of cycles.h. The counter does not run, so all cycle
+ *           measurements read 0.
+ */
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+#include <stdint.h>
+
+typedef struct {
+  volatile uint8_t  CTRLA;
+  volatile uint8_t  CTRLB;
+  volatile uint16_t CNT;
+  volatile uint16_t PER;
+} TC_t;
+
+extern TC_t TCD0;
+
+#define TC_WGMODE_NORMAL_gc     0x00
+#define TC_CLKSEL_DIV1_gc       0x01
+
+#endif // HOST_AVR_IO_H_
@@ -0,0 +1,25 @@
+/*!
+ *  \file    pgmspace.h
+ *  \brief   Host shim of <avr/pgmspace.h>
+ *
+ *  \details Flash data is ordinary const data. A far address is the
+ *           address in a uint32_t, so link with -no-pie to keep the
+ *           constant data below 4 GB.
+ */
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s)                   (s)
+#define pgm_read_byte(p)          (*(const uint8_t *) (p))
+#define pgm_read_word(p)          (*(const uint16_t *) (p))
+#define pgm_read_dword(p)         (*(const uint32_t *) (p))
+#define pgm_get_far_address(x)    ((uint32_t) (uintptr_t) &(x))
+#define memcpy_P(d, s, n)         memcpy(d, s, n)
+#define memcpy_PF(d, a, n)        memcpy(d, (const void *) (uintptr_t) (a), n)
+#define strcmp_P(a, b)            strcmp(a, b)
+
+#endif // HOST_AVR_PGMSPACE_H_
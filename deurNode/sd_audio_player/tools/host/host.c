@@ -0,0 +1,153 @@
+/*!
+ *  \file    host.c
+ *  \brief   Host build of the audio engine: SD-card image
+ *
+ *  \details Sectors are read from and written to the image file with
+ *           stdio. The async and timer functions of sdmm.c are not here;
+ *           the audio engine only uses disk_read().
+ */
+#include "host.h"
+
+#include <stdio.h>
+#include <avr/io.h>
+
+#include "ff.h"
+#include "diskio.h"
+
+TC_t TCD0;                              //!< cycle counter of cycles.h, stands still
+
+static FILE     *image;                 //!< open image, NULL if none
+static uint32_t  sectors;               //!< size of the image in sectors
+static uint32_t  reads;                 //!< number of disk_read() calls
+
+/*! \brief  Open an image of an SD-card as drive 0
+ *
+ *  \param  path     name of the image file
+ *
+ *  \return 0 on success, -1 if the file cannot be opened
+ */
+int host_image_open(const char *path)
+{
+  long size;
+
+  if ( !(image = fopen(path, "r+b")) ) return -1;
+  fseek(image, 0, SEEK_END);
+  size = ftell(image);
+  sectors = size / FF_MIN_SS;
+  reads = 0;
+
+  return 0;
+}
+
+/*! \brief  Close the image
+ *
+ *  \return void
+ */
+void host_image_close(void)
+{
+  if (image) fclose(image);
+  image = NULL;
+}
+
+/*! \brief  Get the number of disk_read() calls since the image was opened
+ *
+ *  \return number of calls
+ */
+uint32_t host_image_reads(void)
+{
+  return reads;
+}
+
+/*! \brief  Initialize the drive: the image is ready once it is open
+ *
+ *  \param  pdrv     drive number, only 0
+ *
+ *  \return status, see disk_status()
+ */
+DSTATUS disk_initialize(BYTE pdrv)
+{
+  return disk_status(pdrv);
+}
+
+/*! \brief  Get the status of the drive
+ *
+ *  \param  pdrv     drive number, only 0
+ *
+ *  \return 0, or STA_NOINIT if there is no open image
+ */
+DSTATUS disk_status(BYTE pdrv)
+{
+  return (pdrv || !image) ? STA_NOINIT : 0;
+}
+
+/*! \brief  Read sectors from the image
+ *
+ *  \param  pdrv     drive number, only 0
+ *  \param  buff     pointer to store the data
+ *  \param  sector   first sector
+ *  \param  count    number of sectors
+ *
+ *  \return RES_OK, RES_NOTRDY, RES_PARERR or RES_ERROR
+ */
+DRESULT disk_read(BYTE pdrv, BYTE *buff, LBA_t sector, UINT count)
+{
+  if (disk_status(pdrv)) return RES_NOTRDY;
+  if (sector + count > sectors) return RES_PARERR;
+
+  reads++;
+  fseek(image, (long) sector * FF_MIN_SS, SEEK_SET);
+
+  return fread(buff, FF_MIN_SS, count, image) == count ? RES_OK : RES_ERROR;
+}
+
+/*! \brief  Write sectors to the image
+ *
+ *  \param  pdrv     drive number, only 0
+ *  \param  buff     data to write
+ *  \param  sector   first sector
+ *  \param  count    number of sectors
+ *
+ *  \return RES_OK, RES_NOTRDY, RES_PARERR or RES_ERROR
+ */
+DRESULT disk_write(BYTE pdrv, const BYTE *buff, LBA_t sector, UINT count)
+{
+  if (disk_status(pdrv)) return RES_NOTRDY;
+  if (sector + count > sectors) return RES_PARERR;
+
+  fseek(image, (long) sector * FF_MIN_SS, SEEK_SET);
+
+  return fwrite(buff, FF_MIN_SS, count, image) == count ? RES_OK : RES_ERROR;
+}
+
+/*! \brief  Control the drive: the commands that FatFs uses
+ *
+ *  \param  pdrv     drive number, only 0
+ *  \param  cmd      CTRL_SYNC, GET_SECTOR_COUNT, GET_SECTOR_SIZE,
+ *                   GET_BLOCK_SIZE or CTRL_TRIM
+ *  \param  buff     pointer to store the result
+ *
+ *  \return RES_OK, RES_NOTRDY or RES_PARERR for another command
+ */
+DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+{
+  if (disk_status(pdrv)) return RES_NOTRDY;
+
+  switch (cmd) {
+    case CTRL_SYNC :
+      fflush(image);
+      return RES_OK;
+    case GET_SECTOR_COUNT :
+      *(LBA_t *) buff = sectors;
+      return RES_OK;
+    case GET_SECTOR_SIZE :
+      *(WORD *) buff = FF_MIN_SS;
+      return RES_OK;
+    case GET_BLOCK_SIZE :
+      *(DWORD *) buff = 1;
+      return RES_OK;
+    case CTRL_TRIM :
+      return RES_OK;
+    default :
+      return RES_PARERR;
+  }
+}
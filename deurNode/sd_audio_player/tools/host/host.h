@@ -0,0 +1,24 @@
+/*!
+ *  \file    host.h
+ *  \brief   Host build of the audio engine: SD-card image
+ *
+ *  \details host.c replaces sdmm.c and the registers on a PC: disk_read()
+ *           and disk_write() work on an image file of an SD-card, e.g. made
+ *           with
+ *           \verbatim
+               mkfs.vfat -C sd.img 16384
+               mcopy -i sd.img audio.wav :: \endverbatim
+ *
+ *           Build with -Itools/host in front of the other include paths, so
+ *           the shims in tools/host/avr and tools/host/util are used.
+ */
+#ifndef HOST_H_
+#define HOST_H_
+
+#include <stdint.h>
+
+int      host_image_open(const char *path);
+void     host_image_close(void);
+uint32_t host_image_reads(void);
+
+#endif // HOST_H_
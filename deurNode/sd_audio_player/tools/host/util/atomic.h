@@ -0,0 +1,16 @@
+/*!
+ *  \file    atomic.h
+ *  \brief   Host shim of <util/atomic.h>
+ *
+ *  \details The host build has no interrupts: the "interrupt" functions
+ *           of the player are called from the same thread, so the block
+ *           runs once without any locking.
+ */
+#ifndef HOST_UTIL_ATOMIC_H_
+#define HOST_UTIL_ATOMIC_H_
+
+#define ATOMIC_RESTORESTATE     0
+#define ATOMIC_FORCEON          0
+#define ATOMIC_BLOCK(type)      for (int atomic_once_ = 1; atomic_once_; atomic_once_ = 0)
+
+#endif // HOST_UTIL_ATOMIC_H_
@@ -0,0 +1,213 @@
+/*!
+ *  \file    mkflashbank.c
+ *  \brief   Generates audio/flashbank_data.h from a folder of WAV files
+ *
+ *  \details Host program (Linux). Build and run it from the project folder:
+ *           \verbatim
+               gcc -O2 -o mkflashbank tools/mkflashbank.c -lm
+               ./mkflashbank 16000 flash > audio/flashbank_data.h \endverbatim
+ *
+ *           The first argument is the rate of the bank, it must be the
+ *           output rate of the player (player_rate()). Every *.wav file of
+ *           the folder becomes a clip named after the file, without the
+ *           extension and in lower case. PCM files with 8 or 16 bits, mono
+ *           or stereo, at any rate are accepted. Stereo is averaged to mono
+ *           and other rates are converted with a windowed sinc filter. The
+ *           samples are stored as 8-bit unsigned values.
+ *
+ *           Every clip gets its own array because avr-gcc does not allow
+ *           objects larger than 32767 bytes; longer clips are cut. The far
+ *           flash address of a clip is taken at run time by flashbank_addr().
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <dirent.h>
+
+#define NAME_LEN    12                  // must match FLASHBANK_NAME in flashbank.h
+#define MAX_LEN     32767               // largest object of avr-gcc
+#define HALF_TAPS   16                  // taps on each side of the resampling filter
+
+static uint16_t rd16(const uint8_t *p) { return p[0] | p[1] << 8; }
+static uint32_t rd32(const uint8_t *p) { return rd16(p) | (uint32_t) rd16(p + 2) << 16; }
+
+static double sinc(double x)
+{
+  return x == 0.0 ? 1.0 : sin(M_PI * x) / (M_PI * x);
+}
+
+/* Read a PCM WAV file as mono samples in -1 .. 1 */
+static double *load_wav(const char *path, long *n, long *rate)
+{
+  FILE    *f = fopen(path, "rb");
+  uint8_t *buf, *p, *end, *data = 0;
+  long     size, i;
+  int      ch = 0, bits = 0, fmt = 0;
+  uint32_t len, data_len = 0;
+  double  *x;
+
+  if (!f) return 0;
+  fseek(f, 0, SEEK_END);
+  size = ftell(f);
+  rewind(f);
+  buf = malloc(size);
+  if (fread(buf, 1, size, f) != (size_t) size || size < 12 ||
+      memcmp(buf, "RIFF", 4) || memcmp(buf + 8, "WAVE", 4)) {
+    fclose(f);
+    free(buf);
+    return 0;
+  }
+  fclose(f);
+
+  for (p = buf + 12, end = buf + size; p + 8 <= end; p += 8 + len + (len & 1)) {
+    len = rd32(p + 4);
+    if (p + 8 + len > end) len = end - p - 8;
+    if (!memcmp(p, "fmt ", 4) && len >= 16) {
+      fmt   = rd16(p + 8);
+      ch    = rd16(p + 10);
+      *rate = rd32(p + 12);
+      bits  = rd16(p + 22);
+      if (fmt == 0xFFFE && len >= 40) fmt = rd16(p + 32);   // WAVE_FORMAT_EXTENSIBLE
+    } else if (!memcmp(p, "data", 4)) {
+      data     = p + 8;
+      data_len = len;
+    }
+  }
+  if (fmt != 1 || (bits != 8 && bits != 16) || (ch != 1 && ch != 2) || !data) {
+    free(buf);
+    return 0;
+  }
+
+  *n = data_len / (ch * bits / 8);
+  x  = malloc((*n + 1) * sizeof(double));
+  for (i = 0; i < *n; i++) {
+    p = data + i * ch * bits / 8;
+    if (bits == 8) {
+      x[i] = ch == 1 ? (p[0] - 128) / 128.0 : (p[0] + p[1] - 256) / 256.0;
+    } else {
+      x[i] = ch == 1 ? (int16_t) rd16(p) / 32768.0
+                     : ((int16_t) rd16(p) + (int16_t) rd16(p + 2)) / 65536.0;
+    }
+  }
+  free(buf);
+
+  return x;
+}
+
+/* Convert to another rate with a Blackman windowed sinc */
+static double *convert(const double *x, long n, long fin, long fout, long *m)
+{
+  double *y, t, d, w, fc, acc, sum;
+  long    i, k, c;
+  double  scale = fout < fin ? (double) fin / fout : 1.0;
+  int     half  = (int) ceil(HALF_TAPS * scale);
+
+  fc = 0.45 * (fin < fout ? fin : fout) / fin;
+  *m = (long) ((double) n * fout / fin);
+  y  = malloc((*m + 1) * sizeof(double));
+  for (i = 0; i < *m; i++) {
+    t   = (double) i * fin / fout;
+    c   = (long) floor(t);
+    acc = sum = 0.0;
+    for (k = c - half + 1; k <= c + half; k++) {
+      d = t - k;
+      w = 0.42 + 0.5 * cos(M_PI * d / half) + 0.08 * cos(2 * M_PI * d / half);
+      w *= 2 * fc * sinc(2 * fc * d);
+      sum += w;
+      if (k >= 0 && k < n) acc += w * x[k];
+    }
+    y[i] = acc / sum;
+  }
+
+  return y;
+}
+
+static int by_name(const void *a, const void *b)
+{
+  return strcmp(*(char * const *) a, *(char * const *) b);
+}
+
+int main(int argc, char *argv[])
+{
+  DIR           *dir;
+  struct dirent *de;
+  char          *files[255], path[1024], name[NAME_LEN];
+  long           lengths[255], fout, fin = 0, n, m, i, v;
+  int            count = 0, c, k;
+  double        *x, *y;
+  size_t         len;
+
+  if (argc != 3 || (fout = atol(argv[1])) <= 0 || !(dir = opendir(argv[2]))) {
+    fprintf(stderr, "usage: %s rate folder\n", argv[0]);
+    return 1;
+  }
+  while ( (de = readdir(dir)) && count < 255 ) {
+    len = strlen(de->d_name);
+    if (len > 4 && !strcasecmp(de->d_name + len - 4, ".wav")) {
+      files[count++] = strdup(de->d_name);
+    }
+  }
+  closedir(dir);
+  qsort(files, count, sizeof(files[0]), by_name);
+
+  printf("/*!\n");
+  printf(" *  \\file    flashbank_data.h\n");
+  printf(" *  \\brief   Sound bank at %ld Hz made from %s/\n", fout, argv[2]);
+  printf(" *\n");
+  printf(" *  \\details Generated by tools/mkflashbank.c, do not edit.\n");
+  printf(" */\n");
+  printf("#ifndef FLASHBANK_DATA_H_\n#define FLASHBANK_DATA_H_\n\n");
+  printf("#include <avr/pgmspace.h>\n\n");
+  printf("#define FLASHBANK_RATE   %-6ld  //!< rate of all clips\n", fout);
+  printf("#define FLASHBANK_CLIPS  %-6d  //!< number of clips\n\n", count);
+
+  for (c = 0; c < count; c++) {
+    snprintf(path, sizeof(path), "%s/%s", argv[2], files[c]);
+    if ( !(x = load_wav(path, &n, &fin)) ) {
+      fprintf(stderr, "%s: not a PCM WAV file\n", path);
+      return 1;
+    }
+    if (fin == fout) {
+      y = x;
+      m = n;
+    } else {
+      y = convert(x, n, fin, fout, &m);
+    }
+    if (m > MAX_LEN) {
+      fprintf(stderr, "%s: cut to %d samples\n", path, MAX_LEN);
+      m = MAX_LEN;
+    }
+    files[c][strlen(files[c]) - 4] = 0;
+    printf("static const uint8_t flashbank_clip%d[%ld] PROGMEM = {   // %s\n", c, m, files[c]);
+    for (i = 0; i < m; i++) {
+      v = lround(128.0 + 127.0 * y[i]);
+      v = v < 0 ? 0 : v > 255 ? 255 : v;
+      printf("%s%3ld%s", i % 16 ? "" : "  ", v, i == m - 1 ? "\n" : i % 16 == 15 ? ",\n" : ",");
+    }
+    printf("};\n\n");
+    lengths[c] = m;
+    if (y != x) free(y);
+    free(x);
+  }
+
+  printf("static const flashbank_entry_t flashbank_index[%d] PROGMEM = {\n", count ? count : 1);
+  for (c = 0; c < count; c++) {
+    memset(name, 0, sizeof(name));
+    for (k = 0; k < NAME_LEN - 1 && files[c][k]; k++) name[k] = tolower((unsigned char) files[c][k]);
+    printf("  { \"%s\", %ld },\n", name, lengths[c]);
+  }
+  if (count == 0) printf("  { \"\", 0 }\n");
+  printf("};\n\n");
+
+  printf("/*! \\brief  Far flash address of a clip */\n");
+  printf("static uint32_t flashbank_addr(uint8_t index)\n{\n  switch (index) {\n");
+  for (c = 0; c < count; c++) {
+    printf("    case %d: return pgm_get_far_address(flashbank_clip%d);\n", c, c);
+  }
+  printf("  }\n\n  return 0;\n}\n\n#endif // FLASHBANK_DATA_H_\n");
+
+  return 0;
+}
@@ -0,0 +1,78 @@
+/*!
+ *  \file    pcmbench.c
+ *  \brief   Times the PCM decode kernels of audio/pcm.c per format
+ *
+ *  \details Host program (Linux, x86). Build and run it from the project
+ *           folder:
+ *           \verbatim
+               gcc -O2 -no-pie -Itools/host -I. -Iff -o pcmbench \
+                   tools/pcmbench.c audio/pcm.c audio/cycles.c tools/host/host.c
+               ./pcmbench [runs] \endverbatim
+ *
+ *           Every kernel decodes a 512-byte block with pcm_decode(), the
+ *           block size of the player, runs times (default 100000). The
+ *           fastest run is taken, in time stamp counter cycles, and printed
+ *           as bytes per cycle and cycles per byte for 8u mono, 8u stereo,
+ *           16s mono and 16s stereo. The numbers compare the kernels with
+ *           each other; on the target pcm_get_load() gives the cycles of the
+ *           AVR with AUDIO_PROFILE set to 1.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <x86intrin.h>
+
+#include "audio/pcm.h"
+
+#define BLOCK   512                     // bytes per block, as PLAYER_IN_LEN
+
+static const struct {
+  const char *name;
+  uint16_t    bits;
+  uint16_t    channels;
+} formats[] = {
+  { "8u mono",    8, 1 },
+  { "8u stereo",  8, 2 },
+  { "16s mono",  16, 1 },
+  { "16s stereo", 16, 2 },
+};
+
+static uint8_t  in[BLOCK];
+static uint16_t out[BLOCK];
+
+int main(int argc, char *argv[])
+{
+  wav_info_t    info = { 0 };
+  pcm_decoder_t dec;
+  uint64_t      t, best;
+  long          runs = argc > 1 ? atol(argv[1]) : 100000;
+  unsigned      f, i;
+  long          r;
+  uint16_t      n;
+
+  for (i = 0; i < BLOCK; i++) in[i] = rand();
+  if (runs < 1) runs = 1;
+
+  printf("%-11s %6s %8s %11s %11s\n", "format", "frames", "cycles", "bytes/cycle", "cycles/byte");
+  for (f = 0; f < sizeof(formats) / sizeof(formats[0]); f++) {
+    info.format   = WAV_FORMAT_PCM;
+    info.bits     = formats[f].bits;
+    info.channels = formats[f].channels;
+    if ( !pcm_select(&dec, &info) ) {
+      printf("%-11s not supported\n", formats[f].name);
+      return 1;
+    }
+    n    = BLOCK / dec.frame_size;
+    best = UINT64_MAX;
+    for (r = 0; r < runs; r++) {
+      t = __rdtsc();
+      pcm_decode(&dec, in, out, n);
+      t = __rdtsc() - t;
+      if (t < best) best = t;
+    }
+    printf("%-11s %6u %8llu %11.3f %11.3f\n", formats[f].name, n,
+           (unsigned long long) best, (double) BLOCK / best, (double) best / BLOCK);
+  }
+
+  return 0;
+}
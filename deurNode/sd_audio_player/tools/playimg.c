@@ -0,0 +1,133 @@
+/*!
+ *  \file    playimg.c
+ *  \brief   Plays WAV files from an SD-card image through the audio engine
+ *
+ *  \details Host program (Linux). Build and run it from the project folder:
+ *           \verbatim
+               gcc -O2 -no-pie -DAUDIO_LATENCY=0 -Itools/host -I. -Iff -o playimg \
+                   tools/playimg.c tools/host/host.c ff/ff.c ff/ffunicode_avr.c \
+                   audio/player.c audio/ring.c audio/wav.c audio/pcm.c audio/adpcm.c \
+                   audio/resample.c audio/headcache.c audio/mixer.c audio/gain.c \
+                   audio/synth.c audio/flashbank.c audio/soundbank.c audio/clipindex.c \
+                   audio/cycles.c
+               ./playimg sd.img out.raw audio.wav bel.wav \endverbatim
+ *
+ *           The first file is started with player_open(), the others are
+ *           queued with player_queue(). The main loop calls player_service()
+ *           and then takes a number of samples (-n, default 64) the way the
+ *           output driver does: one by one with player_next_sample(), or
+ *           with -b in blocks with player_claim_block() and
+ *           player_release_block() like the DMA output. The 12-bit DAC
+ *           codes are written to the output file as 16-bit little endian
+ *           words at player_rate(), and the statistics to stderr.
+ *
+ *           The image is made with mkfs.vfat and mcopy, see tools/host/host.h.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "host.h"
+#include "ff.h"
+#include "audio/player.h"
+
+static FATFS fs;
+static FILE *out;
+
+/*! \brief  Write DAC codes to the output file
+ *
+ *  \param  p        DAC codes
+ *  \param  n        number of codes
+ *
+ *  \return void
+ */
+static void put(const uint16_t *p, uint16_t n)
+{
+  uint16_t i;
+
+  for (i = 0; i < n; i++) {
+    fputc(p[i] & 0xFF, out);
+    fputc(p[i] >> 8, out);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  const uint16_t *blk[2] = { 0, 0 };
+  uint16_t        len[2] = { 0, 0 }, s;
+  player_stats_t  st;
+  FRESULT         res;
+  int             blocks = 0, n = 64, i, k;
+
+  while (argc > 1 && argv[1][0] == '-') {
+    if ( !strcmp(argv[1], "-b") ) {
+      blocks = 1;
+    } else if ( !strcmp(argv[1], "-n") && argc > 2 ) {
+      n = atoi(argv[2]);
+      argv++; argc--;
+    } else {
+      break;
+    }
+    argv++; argc--;
+  }
+  if (argc < 4 || n < 1) {
+    fprintf(stderr, "usage: playimg [-b] [-n samples] image out.raw file.wav [more.wav ..]\n");
+    return 2;
+  }
+  if ( host_image_open(argv[1]) ) {
+    fprintf(stderr, "cannot open %s\n", argv[1]);
+    return 1;
+  }
+  if ( (res = f_mount(&fs, "", 1)) != FR_OK ) {
+    fprintf(stderr, "mount: FatFs error %d\n", res);
+    return 1;
+  }
+  if ( !(out = fopen(argv[2], "wb")) ) {
+    fprintf(stderr, "cannot create %s\n", argv[2]);
+    return 1;
+  }
+
+  if ( (res = player_open(argv[3])) != FR_OK ) {
+    fprintf(stderr, "%s: FatFs error %d\n", argv[3], res);
+    return 1;
+  }
+  for (i = 4; i < argc; i++) {
+    if ( (res = player_queue(argv[i])) != FR_OK ) {
+      fprintf(stderr, "%s: FatFs error %d\n", argv[i], res);
+    }
+  }
+  fprintf(stderr, "rate %u Hz\n", player_rate());
+
+  if (blocks) {                         // two blocks in the DMA channels
+    blk[0] = player_claim_block(&len[0]);
+    blk[1] = player_claim_block(&len[1]);
+  }
+  while ( player_service() ) {
+    for (k = 0; k < n; ) {
+      if (blocks) {
+        put(blk[0], len[0]);
+        k += len[0];
+        player_release_block();
+        blk[0] = blk[1];
+        len[0] = len[1];
+        blk[1] = player_claim_block(&len[1]);
+      } else {
+        s = player_next_sample();
+        put(&s, 1);
+        k++;
+      }
+    }
+  }
+
+  player_get_stats(&st);
+  fprintf(stderr, "samples %lu, underruns %u, tracks %u, skipped %u, gap max %u\n",
+          (unsigned long) st.samples, st.underruns, st.tracks, st.skipped, st.gap_max);
+  fprintf(stderr, "blocks %u, direct %u, disk_read() calls %lu\n",
+          st.blocks, st.direct, (unsigned long) host_image_reads());
+
+  fclose(out);
+  f_unmount("");
+  host_image_close();
+
+  return 0;
+}
@@ -0,0 +1,139 @@
+/*!
+ *  \file    sbcheck.c
+ *  \brief   Checks a sound bank made by tools/sbpack.c
+ *
+ *  \details Host program (Linux). Build and run it from the project folder:
+ *           \verbatim
+               gcc -O2 -o sbcheck tools/sbcheck.c
+               ./sbcheck sounds.bnk \endverbatim
+ *
+ *           Checks the header, the hash of the index, and the format, the
+ *           alignment and the place of every clip, the same way as
+ *           soundbank_mount() does, and lists the clips. Clips that
+ *           overlap and ids that are used twice are reported too. The exit
+ *           code is 0 for a valid bank.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SECTOR      512                 // must match SOUNDBANK_SECTOR in soundbank.h
+#define VERSION     1                   // must match SOUNDBANK_VERSION
+#define CLIPS       16                  // must match SOUNDBANK_CLIPS
+#define HEADER_LEN  16
+#define ENTRY_LEN   16
+
+static uint16_t rd16(const uint8_t *p) { return p[0] | p[1] << 8; }
+static uint32_t rd32(const uint8_t *p) { return rd16(p) | (uint32_t) rd16(p + 2) << 16; }
+
+static uint32_t fnv1a(const uint8_t *p, size_t n)
+{
+  uint32_t h = 2166136261UL;
+
+  while (n--) {
+    h ^= *p++;
+    h *= 16777619UL;
+  }
+
+  return h;
+}
+
+int main(int argc, char *argv[])
+{
+  FILE          *f;
+  uint8_t       *buf, *e, *o;
+  long           size;
+  uint32_t       sectors, index_sectors, sector, length, end;
+  unsigned       count, fmt, ch, rate, align, i, j;
+  int            errors = 0;
+
+  if (argc != 2 || !(f = fopen(argv[1], "rb"))) {
+    fprintf(stderr, "usage: %s bank\n", argv[0]);
+    return 2;
+  }
+  fseek(f, 0, SEEK_END);
+  size = ftell(f);
+  rewind(f);
+  buf = malloc(size + HEADER_LEN);
+  if (fread(buf, 1, size, f) != (size_t) size || size < HEADER_LEN) {
+    fprintf(stderr, "%s: too short\n", argv[1]);
+    return 1;
+  }
+  fclose(f);
+
+  if (memcmp(buf, "SBNK", 4) || buf[4] != VERSION) {
+    fprintf(stderr, "%s: not a sound bank of version %d\n", argv[1], VERSION);
+    return 1;
+  }
+  count         = buf[5];
+  index_sectors = rd16(buf + 6);
+  sectors       = rd32(buf + 8);
+  if ((uint64_t) index_sectors * SECTOR < HEADER_LEN + count * ENTRY_LEN || sectors < index_sectors) {
+    fprintf(stderr, "%s: index of %u clips does not fit in %u sectors\n", argv[1], count, index_sectors);
+    return 1;
+  }
+  if ((uint64_t) sectors * SECTOR > (uint64_t) size) {
+    fprintf(stderr, "%s: %ld bytes, the header says %u sectors\n", argv[1], size, sectors);
+    return 1;
+  }
+  if (size % SECTOR) {
+    printf("warning: %ld bytes is not a whole number of sectors\n", size);
+  }
+  if (fnv1a(buf + HEADER_LEN, count * ENTRY_LEN) != rd32(buf + 12)) {
+    printf("error: hash of the index does not match\n");
+    errors++;
+  }
+  if (count > CLIPS) {
+    printf("error: %u clips, the player keeps %d in RAM (SOUNDBANK_CLIPS)\n", count, CLIPS);
+    errors++;
+  }
+
+  for (i = 0; i < count; i++) {
+    e      = buf + HEADER_LEN + i * ENTRY_LEN;
+    fmt    = e[2];
+    ch     = e[3];
+    rate   = rd16(e + 4);
+    align  = rd16(e + 6);
+    sector = rd32(e + 8);
+    length = rd32(e + 12);
+    end    = sector + (length + SECTOR - 1) / SECTOR;
+    printf("%5u  sector %6u  %6u bytes  %s %u ch %u Hz\n", rd16(e), sector, length,
+           fmt == 1 ? "PCM" : fmt == 0x11 ? "ADPCM" : "?", ch, rate);
+
+    if (fmt != 1 && fmt != 0x11) {
+      printf("error: clip %u: format %u is not PCM or IMA ADPCM\n", rd16(e), fmt);
+      errors++;
+    }
+    if (ch == 0 || rate == 0 || align == 0 || (fmt == 1 && align % ch)) {
+      printf("error: clip %u: invalid channels, rate or block size\n", rd16(e));
+      errors++;
+    }
+    if (fmt == 0x11 && align % SECTOR) {
+      printf("error: clip %u: ADPCM blocks of %u bytes are not whole sectors\n", rd16(e), align);
+      errors++;
+    }
+    if (fmt == 1 && length % align) {
+      printf("warning: clip %u: partial last frame\n", rd16(e));
+    }
+    if (sector < index_sectors || sector > sectors || end > sectors) {
+      printf("error: clip %u: sectors %u .. %u outside the bank\n", rd16(e), sector, end);
+      errors++;
+    }
+    for (j = 0; j < i; j++) {
+      o = buf + HEADER_LEN + j * ENTRY_LEN;
+      if (rd16(o) == rd16(e)) {
+        printf("error: id %u is used twice\n", rd16(e));
+        errors++;
+      }
+      if (length && rd32(o + 12) && sector < rd32(o + 8) + (rd32(o + 12) + SECTOR - 1) / SECTOR &&
+          rd32(o + 8) < end) {
+        printf("error: clips %u and %u overlap\n", rd16(o), rd16(e));
+        errors++;
+      }
+    }
+  }
+  printf("%u clips, %u sectors, %d errors\n", count, sectors, errors);
+
+  return errors ? 1 : 0;
+}
@@ -0,0 +1,202 @@
+/*!
+ *  \file    sbpack.c
+ *  \brief   Packs WAV files into a sound bank for the SD-card
+ *
+ *  \details Host program (Linux). Build and run it from the project folder:
+ *           \verbatim
+               gcc -O2 -o sbpack tools/sbpack.c
+               ./sbpack sounds.bnk 1:bel.wav 2:alarm.wav 10:welkom.wav \endverbatim
+ *
+ *           Every argument after the bank is a WAV file with the id of the
+ *           clip before the colon; without an id the clip gets the id of the
+ *           previous clip plus one (the first gets 1). The "data" chunk of
+ *           every file is copied as it is, so the format must be one the
+ *           player decodes: PCM or IMA ADPCM with blocks of 512 bytes. The
+ *           format is described in audio/soundbank.h; check a bank with
+ *           tools/sbcheck.c.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#define SECTOR      512                 // must match SOUNDBANK_SECTOR in soundbank.h
+#define VERSION     1                   // must match SOUNDBANK_VERSION
+#define MAX_CLIPS   255
+#define HEADER_LEN  16
+#define ENTRY_LEN   16
+
+typedef struct {
+  uint16_t id;
+  uint8_t  format, channels;
+  uint16_t rate, block_align;
+  uint32_t sector, length;
+  uint8_t *data;
+} clip_t;
+
+static uint16_t rd16(const uint8_t *p) { return p[0] | p[1] << 8; }
+static uint32_t rd32(const uint8_t *p) { return rd16(p) | (uint32_t) rd16(p + 2) << 16; }
+static void     wr16(uint8_t *p, uint16_t v) { p[0] = v; p[1] = v >> 8; }
+static void     wr32(uint8_t *p, uint32_t v) { wr16(p, v); wr16(p + 2, v >> 16); }
+
+static uint32_t fnv1a(const uint8_t *p, size_t n)
+{
+  uint32_t h = 2166136261UL;
+
+  while (n--) {
+    h ^= *p++;
+    h *= 16777619UL;
+  }
+
+  return h;
+}
+
+/* Read the format and the data chunk of a WAV file */
+static int load_wav(const char *path, clip_t *c)
+{
+  FILE    *f = fopen(path, "rb");
+  uint8_t *buf, *p, *end, *data = 0;
+  long     size;
+  uint32_t len;
+  int      fmt = -1, ch = 0, bits = 0, align = 0;
+  long     rate = 0;
+
+  if (!f) {
+    fprintf(stderr, "%s: cannot open\n", path);
+    return 0;
+  }
+  fseek(f, 0, SEEK_END);
+  size = ftell(f);
+  rewind(f);
+  buf = malloc(size);
+  if (fread(buf, 1, size, f) != (size_t) size || size < 12 ||
+      memcmp(buf, "RIFF", 4) || memcmp(buf + 8, "WAVE", 4)) {
+    fprintf(stderr, "%s: not a WAV file\n", path);
+    fclose(f);
+    free(buf);
+    return 0;
+  }
+  fclose(f);
+
+  for (p = buf + 12, end = buf + size; p + 8 <= end; p += 8 + len + (len & 1)) {
+    len = rd32(p + 4);
+    if (p + 8 + len > end) len = end - p - 8;
+    if (!memcmp(p, "fmt ", 4) && len >= 16) {
+      fmt   = rd16(p + 8);
+      ch    = rd16(p + 10);
+      rate  = rd32(p + 12);
+      align = rd16(p + 20);
+      bits  = rd16(p + 22);
+      if (fmt == 0xFFFE && len >= 40) fmt = rd16(p + 32);   // WAVE_FORMAT_EXTENSIBLE
+    } else if (!memcmp(p, "data", 4)) {
+      data      = p + 8;
+      c->length = len;
+    }
+  }
+  if (!data) {
+    fprintf(stderr, "%s: no data chunk\n", path);
+  } else if (fmt != 1 && fmt != 0x11) {
+    fprintf(stderr, "%s: format %d is not PCM or IMA ADPCM\n", path, fmt);
+  } else if (fmt == 1 && (bits != 8 && bits != 16)) {
+    fprintf(stderr, "%s: %d bits are not supported\n", path, bits);
+  } else if (fmt == 0x11 && align != SECTOR) {
+    fprintf(stderr, "%s: ADPCM blocks must be %d bytes, not %d\n", path, SECTOR, align);
+  } else if (ch < 1 || ch > 2 || rate < 1 || rate > 65535 || align < 1) {
+    fprintf(stderr, "%s: %d channels at %ld Hz are not supported\n", path, ch, rate);
+  } else {
+    c->format      = fmt;
+    c->channels    = ch;
+    c->rate        = rate;
+    c->block_align = align;
+    c->data        = malloc(c->length);
+    memcpy(c->data, data, c->length);
+    free(buf);
+    return 1;
+  }
+  free(buf);
+
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  static clip_t clips[MAX_CLIPS];
+  static uint8_t zero[SECTOR];
+  FILE     *out;
+  uint8_t  *index, *e;
+  char     *colon, *path;
+  uint32_t  sector, index_sectors;
+  size_t    index_len;
+  int       count = argc - 2, i, j, id = 0;
+
+  if (argc < 3 || count > MAX_CLIPS) {
+    fprintf(stderr, "usage: %s bank [id:]file.wav ...\n", argv[0]);
+    return 1;
+  }
+
+  index_len     = HEADER_LEN + count * ENTRY_LEN;
+  index_sectors = (index_len + SECTOR - 1) / SECTOR;
+  sector        = index_sectors;
+  for (i = 0; i < count; i++) {
+    path  = argv[i + 2];
+    colon = strchr(path, ':');
+    if (colon) {
+      id   = atoi(path);
+      path = colon + 1;
+    } else {
+      id++;
+    }
+    if (id < 0 || id > 65535) {
+      fprintf(stderr, "%s: id %d out of range\n", path, id);
+      return 1;
+    }
+    for (j = 0; j < i; j++) {
+      if (clips[j].id == id) {
+        fprintf(stderr, "%s: id %d is used twice\n", path, id);
+        return 1;
+      }
+    }
+    clips[i].id = id;
+    if (!load_wav(path, &clips[i])) return 1;
+    clips[i].sector = sector;
+    sector += (clips[i].length + SECTOR - 1) / SECTOR;
+  }
+
+  index = calloc(index_sectors, SECTOR);
+  for (i = 0; i < count; i++) {
+    e = index + HEADER_LEN + i * ENTRY_LEN;
+    wr16(e,      clips[i].id);
+    e[2] =       clips[i].format;
+    e[3] =       clips[i].channels;
+    wr16(e + 4,  clips[i].rate);
+    wr16(e + 6,  clips[i].block_align);
+    wr32(e + 8,  clips[i].sector);
+    wr32(e + 12, clips[i].length);
+  }
+  memcpy(index, "SBNK", 4);
+  index[4] = VERSION;
+  index[5] = count;
+  wr16(index + 6,  index_sectors);
+  wr32(index + 8,  sector);
+  wr32(index + 12, fnv1a(index + HEADER_LEN, count * ENTRY_LEN));
+
+  if ( !(out = fopen(argv[1], "wb")) ) {
+    fprintf(stderr, "%s: cannot create\n", argv[1]);
+    return 1;
+  }
+  fwrite(index, SECTOR, index_sectors, out);
+  for (i = 0; i < count; i++) {
+    fwrite(clips[i].data, 1, clips[i].length, out);
+    fwrite(zero, 1, (SECTOR - clips[i].length % SECTOR) % SECTOR, out);
+    printf("%5u  sector %6u  %6u bytes  %s %u ch %u Hz\n", clips[i].id, clips[i].sector,
+           clips[i].length, clips[i].format == 1 ? "PCM" : "ADPCM",
+           clips[i].channels, clips[i].rate);
+  }
+  if (fclose(out) != 0) {
+    fprintf(stderr, "%s: write error\n", argv[1]);
+    return 1;
+  }
+  printf("%d clips, %u sectors\n", count, sector);
+
+  return 0;
+}